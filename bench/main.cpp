@@ -0,0 +1,14 @@
+#include "qtilelayoutbench.h"
+
+#include <QtWidgets/QApplication>
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication a(argc, argv);
+    QTileLayoutBench bench;
+    return QTest::qExec(&bench, argc, argv);
+}
@@ -0,0 +1,227 @@
+#include "qtilelayoutbench.h"
+
+/*
+ * Benchmarks of the core QTileLayout operations, parameterized over the grid size and the span of the hosted widgets.
+ * The first four rows are kept free so that widgets can be added and resized there.
+ * Run with "-o results.csv,csv" (or xml, junitxml, ...) to get machine-readable results.
+ */
+
+void QTileLayoutBench::addGridSizes(void)
+{
+    QTest::addColumn<int>("size");
+
+    for (int size : this->GRID_SIZES) {
+        QTest::addRow("%dx%d", size, size) << size;
+    }
+}
+
+void QTileLayoutBench::addGridSizesAndShapes(void)
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("rowSpan");
+    QTest::addColumn<int>("columnSpan");
+
+    for (int size : this->GRID_SIZES) {
+        for (const QPair<int, int> &shape : this->SPAN_SHAPES) {
+            QTest::addRow("%dx%d/%dx%d", size, size, shape.first, shape.second) << size << shape.first << shape.second;
+        }
+    }
+}
+
+QTileLayout* QTileLayoutBench::createLayout(QWidget &window, const int size)
+{
+    QTileLayout *layout = new QTileLayout(size, size, 16, 16, 1, 1);
+    window.setLayout(layout);
+    return layout;
+}
+
+void QTileLayoutBench::populate(QTileLayout* const layout, const int rowSpan, const int columnSpan)
+{
+    layout->beginUpdate();
+    for (int row = 4; row + rowSpan <= layout->rowCount(); row += rowSpan) {
+        for (int column = 0; column + columnSpan <= layout->columnCount(); column += columnSpan) {
+            layout->addWidget(new QWidget(), row, column, rowSpan, columnSpan);
+        }
+    }
+    layout->endUpdate();
+}
+
+void QTileLayoutBench::construct_data(void)
+{
+    this->addGridSizes();
+}
+
+void QTileLayoutBench::construct(void)
+{
+    QFETCH(int, size);
+
+    QBENCHMARK {
+        QWidget window;
+        this->createLayout(window, size);
+    }
+}
+
+void QTileLayoutBench::addRemoveWidget_data(void)
+{
+    this->addGridSizesAndShapes();
+}
+
+void QTileLayoutBench::addRemoveWidget(void)
+{
+    QFETCH(int, size);
+    QFETCH(int, rowSpan);
+    QFETCH(int, columnSpan);
+
+    QWidget window;
+    QTileLayout *layout = this->createLayout(window, size);
+    this->populate(layout, rowSpan, columnSpan);
+    QWidget *widget = new QWidget(&window);
+
+    int column = 0;
+    QBENCHMARK {
+        layout->addWidget(widget, 0, column, rowSpan, columnSpan);
+        layout->removeWidget(widget);
+        column = (column + columnSpan) % (size - columnSpan + 1);
+    }
+}
+
+void QTileLayoutBench::resizeTile_data(void)
+{
+    this->addGridSizesAndShapes();
+}
+
+void QTileLayoutBench::resizeTile(void)
+{
+    QFETCH(int, size);
+    QFETCH(int, rowSpan);
+    QFETCH(int, columnSpan);
+
+    QWidget window;
+    QTileLayout *layout = this->createLayout(window, size);
+    this->populate(layout, rowSpan, columnSpan);
+    QWidget *widget = new QWidget();
+    layout->addWidget(widget, 0, 0, rowSpan, columnSpan);
+
+    QPair<int, int> right(1, 0);
+    QBENCHMARK {
+        layout->resizeTile(&right, 0, 0, 2);
+        layout->resizeTile(&right, 0, 0, -2);
+    }
+    QCOMPARE(layout->tileOf(widget), QRect(0, 0, columnSpan, rowSpan));
+}
+
+void QTileLayoutBench::moveSelection_data(void)
+{
+    this->addGridSizesAndShapes();
+}
+
+void QTileLayoutBench::moveSelection(void)
+{
+    QFETCH(int, size);
+    QFETCH(int, rowSpan);
+    QFETCH(int, columnSpan);
+
+    QWidget window;
+    QTileLayout *layout = this->createLayout(window, size);
+    this->populate(layout, rowSpan, columnSpan);
+    for (int column = 0; (column + columnSpan <= size) && (layout->selectedWidgets().size() < 20); column += columnSpan) {
+        layout->setSelected(layout->widgetAt(4, column), true);
+    }
+    QWidget *widget = layout->selectedWidgets().first();
+
+    QBENCHMARK {
+        layout->moveSelection(-rowSpan, 0);
+        layout->moveSelection(rowSpan, 0);
+    }
+    QCOMPARE(layout->tileOf(widget), QRect(0, 4, columnSpan, rowSpan));
+}
+
+void QTileLayoutBench::addRemoveRows_data(void)
+{
+    this->addGridSizesAndShapes();
+}
+
+void QTileLayoutBench::addRemoveRows(void)
+{
+    QFETCH(int, size);
+    QFETCH(int, rowSpan);
+    QFETCH(int, columnSpan);
+
+    QWidget window;
+    QTileLayout *layout = this->createLayout(window, size);
+    this->populate(layout, rowSpan, columnSpan);
+
+    QBENCHMARK {
+        layout->addRows(1);
+        layout->removeRows(1);
+    }
+    QCOMPARE(layout->rowCount(), size);
+}
+
+void QTileLayoutBench::addRemoveColumns_data(void)
+{
+    this->addGridSizesAndShapes();
+}
+
+void QTileLayoutBench::addRemoveColumns(void)
+{
+    QFETCH(int, size);
+    QFETCH(int, rowSpan);
+    QFETCH(int, columnSpan);
+
+    QWidget window;
+    QTileLayout *layout = this->createLayout(window, size);
+    this->populate(layout, rowSpan, columnSpan);
+
+    QBENCHMARK {
+        layout->addColumns(1);
+        layout->removeColumns(1);
+    }
+    QCOMPARE(layout->columnCount(), size);
+}
+
+void QTileLayoutBench::updateAllTiles_data(void)
+{
+    this->addGridSizesAndShapes();
+}
+
+void QTileLayoutBench::updateAllTiles(void)
+{
+    QFETCH(int, size);
+    QFETCH(int, rowSpan);
+    QFETCH(int, columnSpan);
+
+    QWidget window;
+    QTileLayout *layout = this->createLayout(window, size);
+    this->populate(layout, rowSpan, columnSpan);
+
+    int height = 16;
+    QBENCHMARK {
+        height = (height == 16)? 17 : 16;
+        layout->setRowsHeight(height);
+    }
+}
+
+void QTileLayoutBench::updateGlobalSize_data(void)
+{
+    this->addGridSizesAndShapes();
+}
+
+void QTileLayoutBench::updateGlobalSize(void)
+{
+    QFETCH(int, size);
+    QFETCH(int, rowSpan);
+    QFETCH(int, columnSpan);
+
+    QWidget window;
+    QTileLayout *layout = this->createLayout(window, size);
+    this->populate(layout, rowSpan, columnSpan);
+
+    QSize small(size * 17, size * 17);
+    QSize large(size * 18, size * 18);
+    bool grow = true;
+    QBENCHMARK {
+        layout->updateGlobalSize(QResizeEvent(grow ? large : small, grow ? small : large));
+        grow = !grow;
+    }
+}
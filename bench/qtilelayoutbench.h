@@ -0,0 +1,41 @@
+#ifndef QTILELAYOUTBENCH_H
+#define QTILELAYOUTBENCH_H
+
+#include <QtWidgets/QtWidgets>
+#include <QtTest/QTest>
+#include "QTileLayout/qtilelayout.h"
+
+class QTileLayoutBench : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void construct_data(void);
+    void construct(void);
+    void addRemoveWidget_data(void);
+    void addRemoveWidget(void);
+    void resizeTile_data(void);
+    void resizeTile(void);
+    void moveSelection_data(void);
+    void moveSelection(void);
+    void addRemoveRows_data(void);
+    void addRemoveRows(void);
+    void addRemoveColumns_data(void);
+    void addRemoveColumns(void);
+    void updateAllTiles_data(void);
+    void updateAllTiles(void);
+    void updateGlobalSize_data(void);
+    void updateGlobalSize(void);
+
+protected:
+    void addGridSizes(void);
+    void addGridSizesAndShapes(void);
+    QTileLayout* createLayout(QWidget &window, const int size);
+    void populate(QTileLayout* const layout, const int rowSpan, const int columnSpan);
+
+    QList<int> GRID_SIZES = {10, 50, 100, 200};
+    QList<QPair<int, int>> SPAN_SHAPES = {{1, 1}, {2, 2}, {1, 4}, {4, 1}};
+
+private:
+};
+#endif // QTILELAYOUTBENCH_H
@@ -0,0 +1,247 @@
+#include <QtWidgets/QtWidgets>
+#include <algorithm>
+#include "QTileLayout/qtilelayout.h"
+
+/*
+ * Replays QTileLayout traces recorded with QTileLayout::startTrace() and prints the timing of every operation as CSV:
+ * trace, operation, count, skipped, total, median, p95 and maximum, all times in nanoseconds.
+ * Usage: QTileLayoutReplay trace_file [trace_file ...]
+ */
+
+static qint64 percentile(QList<qint64> samples, const qreal percent)
+{
+    if (samples.isEmpty()) {
+        return 0;
+    }
+    int index = qMin(int(percent / 100 * samples.size()), int(samples.size()) - 1);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+static bool isAreaFree(QTileLayout &layout, const int row, const int column, const int rowSpan, const int columnSpan)
+{
+    return (row >= 0) && (column >= 0) && (rowSpan > 0) && (columnSpan > 0) &&
+           (row + rowSpan <= layout.rowCount()) && (column + columnSpan <= layout.columnCount()) &&
+           layout.isAreaEmpty(row, column, rowSpan, columnSpan);
+}
+
+static bool replay(const QString &path, QTextStream &output)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning() << "cannot open" << path;
+        return false;
+    }
+
+    QTileTrace trace;
+    trace.setDevice(&file);
+    QTileTrace::Header header;
+    if (!trace.readHeader(header)) {
+        qWarning() << "invalid trace header in" << path;
+        return false;
+    }
+
+    QWidget window;
+    QTileLayout *layout = new QTileLayout(
+        header.rows, header.columns,
+        header.verticalSpan, header.horizontalSpan,
+        header.verticalSpacing, header.horizontalSpacing,
+        header.emptyCellMode
+        );
+    window.setLayout(layout);
+    for (int row = 0; row < header.rowHeights.size(); row++) {
+        if (header.rowHeights[row] > 0) {
+            layout->setRowHeight(row, header.rowHeights[row]);
+        }
+    }
+    for (int column = 0; column < header.columnWidths.size(); column++) {
+        if (header.columnWidths[column] > 0) {
+            layout->setColumnWidth(column, header.columnWidths[column]);
+        }
+    }
+
+    QHash<qint32, QWidget*> widgets;
+    auto widgetOf = [&widgets, &window](const qint32 id) {
+        if (!widgets.contains(id)) {
+            widgets.insert(id, new QWidget(&window));
+        }
+        return widgets[id];
+    };
+
+    QList<QPair<QWidget*, QRect>> placements;
+    for (const QPair<qint32, QRect> &widget : header.widgets) {
+        placements.append({widgetOf(widget.first), widget.second});
+    }
+    layout->addWidgets(placements);
+    window.show();
+    layout->activate();
+
+    QList<QList<qint64>> timings(QTileTrace::OperationCount);
+    QList<int> skipped(QTileTrace::OperationCount, 0);
+    QElapsedTimer timer;
+    QTileTrace::Record record;
+    while (trace.readRecord(record)) {
+        const QList<qint32> &args = record.arguments;
+        bool applied = true;
+
+        timer.start();
+        switch (record.operation) {
+        case QTileTrace::AddWidget:
+        case QTileTrace::DropWidget:
+            applied = (args.size() == 5) && (layout->tileOf(widgetOf(args[0])) == QRect()) && isAreaFree(*layout, args[1], args[2], args[3], args[4]);
+            if (applied) {
+                layout->addWidget(widgetOf(args[0]), args[1], args[2], args[3], args[4]);
+            }
+            break;
+        case QTileTrace::RemoveWidget:
+            applied = (args.size() == 1) && (layout->tileOf(widgetOf(args[0])) != QRect());
+            if (applied) {
+                layout->removeWidget(widgetOf(args[0]));
+            }
+            break;
+        case QTileTrace::ResizeTile: {
+            applied = (args.size() == 5) &&
+                      (args[2] >= 0) && (args[3] >= 0) && (args[2] < layout->rowCount()) && (args[3] < layout->columnCount()) &&
+                      (layout->widgetAt(args[2], args[3]) != nullptr);
+            if (applied) {
+                QPair<int, int> direction(args[0], args[1]);
+                layout->resizeTile(&direction, args[2], args[3], args[4]);
+            }
+            break;
+        }
+        case QTileTrace::UpdateGlobalSize:
+            applied = (args.size() == 2);
+            if (applied) {
+                layout->updateGlobalSize(QSize(args[0], args[1]));
+            }
+            break;
+        case QTileTrace::AddRows:
+            applied = (args.size() == 1) && (args[0] > 0);
+            if (applied) {
+                layout->addRows(args[0]);
+            }
+            break;
+        case QTileTrace::AddColumns:
+            applied = (args.size() == 1) && (args[0] > 0);
+            if (applied) {
+                layout->addColumns(args[0]);
+            }
+            break;
+        case QTileTrace::RemoveRows:
+            applied = (args.size() == 1) && (args[0] > 0) && (args[0] < layout->rowCount()) &&
+                      layout->isAreaEmpty(layout->rowCount() - args[0], 0, args[0], layout->columnCount());
+            if (applied) {
+                layout->removeRows(args[0]);
+            }
+            break;
+        case QTileTrace::RemoveColumns:
+            applied = (args.size() == 1) && (args[0] > 0) && (args[0] < layout->columnCount()) &&
+                      layout->isAreaEmpty(0, layout->columnCount() - args[0], layout->rowCount(), args[0]);
+            if (applied) {
+                layout->removeColumns(args[0]);
+            }
+            break;
+        case QTileTrace::Compact:
+            applied = (args.size() == 1);
+            if (applied) {
+                layout->compact(QTileLayout::CompactionMode(args[0]));
+            }
+            break;
+        case QTileTrace::SelectWidgets:
+            applied = !args.isEmpty();
+            if (applied && (args[0] == 0)) {
+                layout->clearSelection();
+            }
+            for (int index = 1; index < args.size(); index++) {
+                QWidget *widget = widgetOf(args[index]);
+                if (layout->tileOf(widget) != QRect()) {
+                    layout->setSelected(widget, true);
+                } else {
+                    applied = false;
+                }
+            }
+            break;
+        case QTileTrace::MoveSelection:
+            applied = (args.size() == 2) && !layout->selectedWidgets().isEmpty();
+            if (applied) {
+                layout->moveSelection(args[0], args[1]);
+            }
+            break;
+        case QTileTrace::ResizeSelection:
+            applied = (args.size() == 3) && !layout->selectedWidgets().isEmpty();
+            if (applied) {
+                QPair<int, int> direction(args[0], args[1]);
+                layout->resizeSelection(&direction, args[2]);
+            }
+            break;
+        case QTileTrace::SetRowHeight:
+            applied = (args.size() == 2) && (args[0] >= 0) && (args[0] < layout->rowCount()) && (args[1] >= 0);
+            if (applied) {
+                layout->setRowHeight(args[0], args[1]);
+            }
+            break;
+        case QTileTrace::SetColumnWidth:
+            applied = (args.size() == 2) && (args[0] >= 0) && (args[0] < layout->columnCount()) && (args[1] >= 0);
+            if (applied) {
+                layout->setColumnWidth(args[0], args[1]);
+            }
+            break;
+        default:
+            applied = false;
+            break;
+        }
+        layout->activate();
+        qint64 elapsed = timer.nsecsElapsed();
+
+        if (applied) {
+            timings[record.operation].append(elapsed);
+        } else {
+            skipped[record.operation]++;
+        }
+    }
+
+    for (int operation = 0; operation < QTileTrace::OperationCount; operation++) {
+        const QList<qint64> &samples = timings[operation];
+        if (samples.isEmpty() && (skipped[operation] == 0)) {
+            continue;
+        }
+        qint64 total = 0;
+        for (qint64 sample : samples) {
+            total += sample;
+        }
+        output << path << ','
+               << QTileTrace::operationName(QTileTrace::Operation(operation)) << ','
+               << samples.size() << ','
+               << skipped[operation] << ','
+               << total << ','
+               << percentile(samples, 50) << ','
+               << percentile(samples, 95) << ','
+               << (samples.isEmpty() ? 0 : *std::max_element(samples.begin(), samples.end())) << Qt::endl;
+    }
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    if (!qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication a(argc, argv);
+    QStringList paths = a.arguments().mid(1);
+    if (paths.isEmpty()) {
+        qWarning() << "usage: QTileLayoutReplay trace_file [trace_file ...]";
+        return 2;
+    }
+
+    QTextStream output(stdout);
+    output << "trace,operation,count,skipped,total_ns,median_ns,p95_ns,max_ns" << Qt::endl;
+
+    int result = 0;
+    for (const QString &path : paths) {
+        if (!replay(path, output)) {
+            result = 1;
+        }
+    }
+    return result;
+}
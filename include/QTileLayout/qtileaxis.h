@@ -0,0 +1,45 @@
+#ifndef QTILEAXIS_H
+#define QTILEAXIS_H
+
+#include "QTileLayout_global.h"
+
+#include <QtCore/QList>
+
+/*
+ * Geometry of one axis of the tile grid: a default cell size, optional per-cell size overrides and the spacing
+ * between cells. Cell offsets are kept in a prefix-sum table rebuilt lazily after a change, so that pixel to cell
+ * lookups are binary searches. Indexes past the last cell are extrapolated with the default size.
+ */
+class QTILELAYOUT_EXPORT QTileAxis
+{
+public:
+    QTileAxis(void);
+    void resize(const int count);
+    void setDefaultSize(const int size);
+    void setSpacing(const int spacing);
+    bool setSize(const int index, const int size);
+    int size(const int index) const;
+    bool isSizeFixed(const int index) const;
+    int offset(const int index) const;
+    int extent(const int index, const int span) const;
+    int indexAt(const int position) const;
+    int boundaryAt(const int position) const;
+    int count(void) const;
+    int fixedCount(void) const;
+    int fixedTotal(void) const;
+    QList<int> fixedSizes(void) const;
+
+protected:
+    void updateOffsets(void) const;
+
+    int count_;
+    int defaultSize_;
+    int spacing_;
+    QList<int> sizes_;
+    int fixedCount_;
+    int fixedTotal_;
+    mutable QList<int> offsets_;
+    mutable bool offsetsValid_;
+};
+
+#endif // QTILEAXIS_H
@@ -0,0 +1,48 @@
+#ifndef QTILEBACKGROUND_H
+#define QTILEBACKGROUND_H
+
+#include <QtWidgets/QWidget>
+#include <QtGui/QPainter>
+#include <QtGui/QDrag>
+#include <QtCore/QMimeData>
+
+class QTileLayout;
+
+class QTileBackground : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit QTileBackground(QTileLayout* const tileLayout, QWidget* const parent = nullptr);
+    void resizeGrid(const int rows, const int columns, const QColor &color);
+    void setCellColor(const int row, const int column, const QColor &color);
+    void setSelection(const QList<QRect> &areas, const QColor &color);
+    QRect cellRect(const int row, const int column);
+    QRect areaRect(const int row, const int column, const int rowSpan, const int columnSpan);
+    QRect cellsIn(const QRect &rect);
+    bool cellAt(const QPoint &position, int &row, int &column);
+    void dragEnterEvent(QDragEnterEvent *event);
+    void dragMoveEvent(QDragMoveEvent *event);
+    void dropEvent(QDropEvent *event);
+
+protected:
+    bool event(QEvent *event);
+    void paintEvent(QPaintEvent *event);
+    void updateDropTarget(QDragMoveEvent *event);
+
+    QTileLayout* tileLayout_;
+    int rows_;
+    int columns_;
+    QList<QColor> cellColors_;
+    QList<QRect> selectedAreas_;
+    QColor selectionColor_;
+    int dragRow_;
+    int dragColumn_;
+    bool dropPossible_;
+
+signals:
+
+private:
+    typedef QWidget Super;
+};
+
+#endif // QTILEBACKGROUND_H
@@ -0,0 +1,37 @@
+#ifndef QTILEDROPDATA_H
+#define QTILEDROPDATA_H
+
+#include "QTileLayout_global.h"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QMimeData>
+#include <QtCore/QUuid>
+
+/*
+ * Payload of a tile drag, stored in the mime data as a fixed-size little-endian record:
+ * magic (4 bytes), version (2 bytes), reserved (2 bytes), layout id (16 bytes), six 32-bit integers.
+ * The decoded payload is cached for the mime data of the running drag.
+ */
+class QTILELAYOUT_EXPORT QTileDropData
+{
+public:
+    QTileDropData(void);
+    QByteArray encode(void) const;
+    bool decode(const QByteArray &data);
+    static const QTileDropData* fromMimeData(const QMimeData* const mimeData);
+    static void clearCache(void);
+
+    QUuid id;
+    int row;
+    int column;
+    int rowSpan;
+    int columnSpan;
+    int rowOffset;
+    int columnOffset;
+
+    static const quint32 MAGIC = 0x444C5451;
+    static const quint16 VERSION = 1;
+    static const int SIZE = 48;
+};
+
+#endif // QTILEDROPDATA_H
@@ -0,0 +1,65 @@
+#ifndef QTILEGRID_H
+#define QTILEGRID_H
+
+#include "QTileLayout_global.h"
+#include "qtileoccupancy.h"
+
+#include <QtCore/QList>
+#include <QtCore/QHash>
+#include <QtCore/QRect>
+#include <QtCore/QPair>
+#include <QtCore/QMetaType>
+
+/*
+ * Widget-free model of a tile grid: the area of every item, keyed by an opaque value, and the cell occupancy.
+ * It is a plain value type without QObject or QWidget dependencies, so a copy taken with QTileLayout::grid()
+ * can be rearranged on any thread and handed back to QTileLayout::applyGrid() on the GUI thread.
+ * Areas are cell rectangles: x is the column, y the row, width the column span and height the row span.
+ */
+class QTILELAYOUT_EXPORT QTileGrid
+{
+public:
+    typedef quintptr Key;
+
+    enum CompactionMode {
+        CompactUp,
+        CompactLeft
+    };
+
+    QTileGrid(void);
+    QTileGrid(const int rows, const int columns);
+    void resize(const int rows, const int columns);
+    int rowCount(void) const;
+    int columnCount(void) const;
+    bool isFilled(const int row, const int column) const;
+    bool isAreaEmpty(const int row, const int column, const int rowSpan, const int columnSpan) const;
+    bool isAreaFree(const Key key, const QRect &area) const;
+    bool findFreeArea(const int rowSpan, const int columnSpan, int &row, int &column, const bool bestFit) const;
+    bool contains(const Key key) const;
+    QRect area(const Key key) const;
+    Key keyAt(const int row, const int column) const;
+    QList<Key> keys(void) const;
+    int size(void) const;
+    bool place(const Key key, const QRect &area);
+    bool move(const Key key, const QRect &area);
+    bool move(const QHash<Key, QRect> &areas);
+    void remove(const Key key);
+    int freeExtent(const QRect &area, const QPair<int, int> &direction) const;
+    QRect resizedArea(const QRect &area, const QPair<int, int> &direction, const int tileCount) const;
+    static QRect resizedArea(const QRect &area, const QPair<int, int> &direction, const int tileCount, const int freeExtent);
+    bool compact(const CompactionMode mode);
+    QHash<Key, QRect> changedAreas(const QTileGrid &grid) const;
+
+protected:
+    void setArea(const Key key, const QRect &area, const bool filled);
+
+    int rows_;
+    int columns_;
+    QTileOccupancy occupancy_;
+    QList<Key> cellKeys_;
+    QHash<Key, QRect> areas_;
+};
+
+Q_DECLARE_METATYPE(QTileGrid)
+
+#endif // QTILEGRID_H
@@ -2,30 +2,89 @@
 #define QTILELAYOUT_H
 
 #include "QTileLayout_global.h"
+#include "qtilegrid.h"
+#include "qtileaxis.h"
+#include "qtilelayoutstats.h"
+#include "qtiletrace.h"
 
 #include <QtWidgets/QGridLayout>
 #include <QtWidgets/QWidget>
+#include <QtWidgets/QAbstractScrollArea>
+#include <QtWidgets/QScrollBar>
+#include <QtCore/QPointer>
 #include <QtCore/QUuid>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QMimeData>
+#include <QtCore/QDataStream>
+#include <QtCore/QTimer>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QCoreApplication>
+#include <functional>
 #include <QtGui/QResizeEvent>
+#include <QtGui/QPixmap>
 
 class QTileWidget;
+class QTileBackground;
 
 class QTILELAYOUT_EXPORT QTileLayout : public QGridLayout
 {
     Q_OBJECT
 public:
-    QTileLayout(const int rows, const int columns, const int verticalSpan = 128, const int horizontalSpan = 128, const int verticalSpacing = 5, const int horizontalSpacing = 5);
-    QTileLayout(QWidget* const parent, const int rows, const int columns, const int verticalSpan = 128, const int horizontalSpan = 128, const int verticalSpacing = 5, const int horizontalSpacing = 5);
+    enum CompactionMode {
+        CompactUp = QTileGrid::CompactUp,
+        CompactLeft = QTileGrid::CompactLeft
+    };
 
+    QTileLayout(const int rows, const int columns, const int verticalSpan = 128, const int horizontalSpan = 128, const int verticalSpacing = 5, const int horizontalSpacing = 5, const bool emptyCellMode = false);
+    QTileLayout(QWidget* const parent, const int rows, const int columns, const int verticalSpan = 128, const int horizontalSpan = 128, const int verticalSpacing = 5, const int horizontalSpacing = 5, const bool emptyCellMode = false);
+
+    void beginUpdate(void);
+    void endUpdate(void);
     void addWidget(QWidget* const widget, const int row, const int column);
     void addWidget(QWidget* const widget, const int row, const int column, const int rowSpan, const int columnSpan);
+    bool addWidgets(const QList<QPair<QWidget*, QRect>> &placements);
+    QWidget* addWidgetFactory(const std::function<QWidget*(void)> &factory, const int row, const int column);
+    QWidget* addWidgetFactory(const std::function<QWidget*(void)> &factory, const int row, const int column, const int rowSpan, const int columnSpan);
+    int pendingWidgetCount(void);
+    void compact(const CompactionMode mode);
+    QTileGrid grid(void);
+    bool applyGrid(const QTileGrid &grid);
+    void setSelected(QWidget* const widget, const bool selected);
+    bool isSelected(QWidget* const widget);
+    QList<QWidget*> selectedWidgets(void);
+    void clearSelection(void);
+    bool moveSelection(const int rowOffset, const int columnOffset);
+    bool resizeSelection(QPair<int, int>* const direction, const int tileCount);
+    bool findFreeArea(const int rowSpan, const int columnSpan, int &row, int &column);
+    bool findBestFreeArea(const int rowSpan, const int columnSpan, int &row, int &column);
+    bool addWidgetAnywhere(QWidget* const widget, const int rowSpan, const int columnSpan, const bool bestFit = false);
     void removeWidget(QWidget* const widget);
+    QByteArray saveState(const QHash<QWidget*, QString> &widgetIds);
+    bool restoreState(const QByteArray &state, const QHash<QString, QWidget*> &widgets);
     void addRows(const int rows);
     void addColumns(const int columns);
     void removeRows(const int rows);
     void removeColumns(const int columns);
     void acceptDragAndDrop(const bool accept);
     void acceptResizing(const bool accept);
+    void acceptSelection(const bool accept);
+    void activateEmptyCellMode(const bool activate);
+    // Off-screen tiles leave the grid and are hidden, but tiles and hosted widgets stay alive: use the
+    // widgetDematerialized/widgetMaterialized signals to release and rebuild heavy content.
+    void activateVirtualization(QAbstractScrollArea* const scrollArea);
+    void deactivateVirtualization(void);
+    void setVirtualizationMargin(const int margin);
+    void activateEventDispatch(const bool activate);
+    void setTilePoolCapacity(const int capacity);
+    int tilePoolSize(void);
+    qreal tilePoolHitRate(void);
+    void clearTilePool(void);
+    void activateStats(const bool activate);
+    const QTileLayoutStats& stats(void);
+    void resetStats(void);
+    void startTrace(QIODevice* const device);
+    void stopTrace(void);
     void setCursorIdle(const Qt::CursorShape &cursor);
     void setCursorGrab(const Qt::CursorShape &cursor);
     void setCursorResizeHorizontal(const Qt::CursorShape &cursor);
@@ -34,6 +93,11 @@ public:
     void setColorResize(const QColor &color);
     void setColorDragAndDrop(const QColor &color);
     void setColorEmptyCheck(const QColor &color);
+    void setColorSelected(const QColor &color);
+    void setDragPixmapMaximumSize(const QSize &size);
+    void activateDragPixmapCache(const bool activate);
+    void setDragOutlineThreshold(const int area);
+    void invalidateDragPixmap(QWidget* const widget);
     int rowCount(void);
     int columnCount(void);
     QRect tileRect(const int row, const int column);
@@ -43,10 +107,18 @@ public:
     void setColumnsMinimumWidth(const int width);
     void setRowsHeight(const int height);
     void setColumnsWidth(const int width);
+    void setRowHeight(const int row, const int height);
+    void setColumnWidth(const int column, const int width);
+    int rowHeight(const int row);
+    int columnWidth(const int column);
+    const QTileAxis& rowAxis(void);
+    const QTileAxis& columnAxis(void);
     void setVerticalSpacing(const int spacing);
     void setHorizontalSpacing(const int spacing);
     QUuid getId(void);
     void activateFocus(const bool focus);
+    QRect tileOf(QWidget* const widget);
+    QWidget* widgetAt(const int row, const int column);
     QList<QWidget*> widgetList(void);
     void linkTileLayout(QTileLayout* const layout);
     void unlinkTileLayout(QTileLayout* const layout);
@@ -54,11 +126,18 @@ public:
     void changeTilesColor(const QColor &color);
     void changeTilesColor(const QColor &color, const int fromRow, const int fromColumn, const int toRow, const int toColumn);
     QWidget* getWidgetToDrop(void);
+    int resizeExtent(QPair<int, int>* const direction, const int row, const int column);
     void highlightTiles(QPair<int, int>* const direction, const int row, const int column, const int tileCount);
+    void highlightTiles(QPair<int, int>* const direction, const int row, const int column, const int tileCount, const int extent);
     void resizeTile(QPair<int, int>* const direction, const int row, const int column, const int tileCount);
+    void resizeTile(QPair<int, int>* const direction, const int row, const int column, const int tileCount, const int extent);
     bool isAreaEmpty(const int row, const int column, const int rowSpan, const int columnSpan);
     bool isAreaEmpty(const int row, const int column, const int rowSpan, const int columnSpan, const QColor &color);
-    void updateGlobalSize(QResizeEvent newSize);
+    bool isDropPossible(const QMimeData* const mimeData, const int row, const int column);
+    void dropWidget(const QMimeData* const mimeData, const int row, const int column);
+    void updateGlobalSize(const QResizeEvent &newSize);
+    void updateGlobalSize(const QSize &size);
+    void activateResizeCoalescing(const bool activate);
 
     int rows;
     int columns;
@@ -71,10 +150,23 @@ public:
     QColor colorIdle;
     QColor colorResize;
     QColor colorEmptyCheck;
+    QColor colorSelected;
+
+    QSize dragPixmapMaximumSize = QSize();
+    bool dragPixmapCache = false;
+    int dragOutlineThreshold = 0;
 
     bool dragAndDrop = true;
     bool resizable = true;
+    bool selectable = false;
     bool focus = false;
+    bool emptyCellMode = false;
+    bool eventDispatch = false;
+    int virtualizationMargin = 256;
+    int tilePoolCapacity = 256;
+    int factoryTimeBudget = 8;
+    bool resizeCoalescing = false;
+    int resizeCoalescingInterval = 16;
     QUuid id;
     QMap<QUuid, QTileLayout*> linkedLayouts;
 
@@ -83,32 +175,102 @@ public:
     Qt::CursorShape cursorResizeV = Qt::CursorShape::SizeVerCursor;
     Qt::CursorShape cursorResizeH = Qt::CursorShape::SizeHorCursor;
 
+public slots:
+    void updateVirtualization(void);
+    void buildPendingWidgets(void);
+
 signals:
     void tileResized(QWidget const *widget, const int row, const int column, const int rowSpan, const int columnSpan);
     void tileMoved(QWidget const *widget, const QUuid fromLayoutId, const QUuid toLayoutId, const int fromRow, const int fromColumn, const int toRow, const int toColumn);
+    void statsUpdated(const QTileLayoutStats &stats);
+    void widgetBuilt(QWidget *placeholder, QWidget *widget);
+    void tilesRearranged(void);
+    void selectionChanged(void);
+    void widgetMaterialized(QWidget *widget);
+    void widgetDematerialized(QWidget *widget);
 
 protected:
-    void init(const int rows, const int columns, const int verticalSpan, const int horizontalSpan, const int verticalSpacing, const int horizontalSpacing);
+    bool eventFilter(QObject *watched, QEvent *event);
+    void materializeTile(QTileWidget* const tile);
+    void dematerializeTile(QTileWidget* const tile);
+    void updateHoverCursor(const QPoint &position);
+    void init(const int rows, const int columns, const int verticalSpan, const int horizontalSpan, const int verticalSpacing, const int horizontalSpacing, const bool emptyCellMode);
     void initTileMap(void);
+    void syncAxes(void);
+    void updateBackground(void);
+    bool isCellFilled(const int row, const int column);
+    void buildWidget(QWidget* const placeholder);
+    void applyGlobalSize(void);
+    qint32 traceWidgetId(QWidget* const widget);
+    void traceSelection(void);
+    void updateSelectionOutline(void);
+    bool applySelection(const QHash<QTileGrid::Key, QRect> &areas);
+    void placeWidget(QWidget* const widget, const int row, const int column, const int rowSpan, const int columnSpan);
     QTileWidget* createTile(const int row, const int column);
     QTileWidget* createTile(const int row, const int column, const bool updateTileMap);
     QTileWidget* createTile(const int row, const int column, const int rowSpan, const int columnSpan);
     QTileWidget* createTile(const int row, const int column, const int rowSpan, const int columnSpan, const bool updateTileMap);
-    void getTilesToBeResized(QTileWidget* const tile, QPair<int, int>* const direction, int &row, int &column, const int &tileCount, QSet<QPair<int, int> > &tilesToMerge, bool &increase, int &rowSpan, int &columnSpan);
-    void getTilesToMerge(QPair<int, int>* const direction, const int &row, const int &column, const int &tileCount, int &tileAvailableCount, QSet<QPair<int, int> > &tilesToMerge);
-    void getTilesToSplit(QPair<int, int>* const direction, const int &row, const int &column, const int &tileCount, int &tileAvailableCount, QSet<QPair<int, int> > &tilesToSplit);
-    void mergeTiles(QTileWidget* const tile, const int row, const int column, const int rowSpan, const int columnSpan, const QSet<QPair<int, int> > &tilesToMerge);
-    void splitTiles(QTileWidget* const tile, const int row, const int column, const int rowSpan, const int columnSpan, const QSet<QPair<int, int> > &tilesToSplit);
+    void mergeTiles(QTileWidget* const tile, const QRect &from, const QRect &to);
+    void splitTiles(QTileWidget* const tile, const QRect &from, const QRect &to);
+    void releaseTile(QTileWidget* const tile);
     QTileWidget* hardSplitTiles(const int row, const int column, const QSet<QPair<int, int>> &tileToSplit);
     void updateAllTiles(void);
+    void gridAddWidget(QWidget* const widget, const int row, const int column, const int rowSpan, const int columnSpan);
+    void gridMoveWidget(QWidget* const widget, const int row, const int column, const int rowSpan, const int columnSpan);
+    void gridRemoveWidget(QWidget* const widget);
+    void applyTilesColor(const QColor &baseColor, const QRect &area, const QColor &areaColor);
+    void changeCellColor(const int row, const int column, const QColor &color);
+    void invalidateTilesColor(const int row, const int column, const int rowSpan, const int columnSpan);
+    void resetTilesColor(void);
+    static QTileGrid::Key gridKey(QWidget* const widget);
 
     QWidget* widgetToDrop_;
+    QTileBackground* background_;
+    int updateDepth_;
+    bool pendingUpdateAllTiles_;
+    QHash<QWidget*, QRect> pendingPlacements_;
+    QSet<QWidget*> pendingRemovals_;
+    QPointer<QAbstractScrollArea> scrollArea_;
+    QRect virtualArea_;
+    QSet<QWidget*> materializedTiles_;
+    bool virtualizationEmptyCellMode_;
+    QPointer<QWidget> dispatchWidget_;
+    QList<QTileWidget*> tilePool_;
+    int tilePoolRequests_;
+    int tilePoolHits_;
+    QTileLayoutStats stats_;
+    bool statsEnabled_;
+    int statsDepth_;
+    QHash<QWidget*, std::function<QWidget*(void)>> widgetFactories_;
+    QList<QWidget*> pendingFactories_;
+    QTimer* factoryTimer_;
+    QTimer* resizeTimer_;
+    QSize pendingGlobalSize_;
+    QTileTrace trace_;
+    int traceDepth_;
+    QHash<QWidget*, qint32> traceWidgetIds_;
     QList<QList<QTileWidget*> > tileMap_;
+    QTileGrid grid_;
+    QTileAxis rowAxis_;
+    QTileAxis columnAxis_;
+    QColor baseColor_;
+    QRect highlightArea_;
+    QRect staleArea_;
+    QHash<QWidget*, QTileWidget*> widgetTiles_;
     QList<QWidget*> widgets_;
-    QList<QTileWidget*> tiles_;
+    QHash<QWidget*, QPixmap> dragPixmaps_;
+    QList<QWidget*> selection_;
 
 private:
     typedef QGridLayout Super;
+    friend class QTileLayoutStatsScope;
+    friend class QTileTraceScope;
+    friend class QTileWidget;
+
+    static const quint32 STATE_MAGIC = 0x534C5451;
+    static const quint16 STATE_VERSION = 2;
+    static const qint64 STATE_MAX_CELLS = qint64(1) << 24;
+    static const qint64 STATE_ENTRY_MIN_SIZE = 20;
 };
 
 #endif // QTILELAYOUT_H
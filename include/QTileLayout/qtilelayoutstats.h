@@ -0,0 +1,102 @@
+#ifndef QTILELAYOUTSTATS_H
+#define QTILELAYOUTSTATS_H
+
+#include "QTileLayout_global.h"
+
+#include <QtCore/QList>
+#include <QtCore/QString>
+#include <QtCore/QElapsedTimer>
+
+class QTileLayout;
+
+/*
+ * Operation counters and timings of a QTileLayout, collected once activateStats(true) is called.
+ * Timings are in nanoseconds; percentiles are computed over the last SAMPLE_CAPACITY samples.
+ * Defining QTILELAYOUT_NO_STATS compiles the instrumentation out of the library.
+ */
+class QTILELAYOUT_EXPORT QTileLayoutStats
+{
+public:
+    enum Counter {
+        TilesAllocated,
+        TilesReused,
+        TilesPooled,
+        TilesDeleted,
+        CellsRecolored,
+        CounterCount
+    };
+
+    enum Operation {
+        AddWidget,
+        AddWidgets,
+        RemoveWidget,
+        ResizeTile,
+        DropWidget,
+        AddRows,
+        AddColumns,
+        RemoveRows,
+        RemoveColumns,
+        RestoreState,
+        Compact,
+        ApplyGrid,
+        MoveSelection,
+        ResizeSelection,
+        UpdateAllTiles,
+        UpdateGlobalSize,
+        ChangeTilesColor,
+        OperationCount
+    };
+
+    QTileLayoutStats(void);
+    void reset(void);
+    void increment(const Counter counter, const qint64 amount = 1);
+    void record(const Operation operation, const qint64 nsecs);
+    qint64 count(const Counter counter) const;
+    qint64 operationCount(const Operation operation) const;
+    qint64 totalTime(const Operation operation) const;
+    qint64 maximumTime(const Operation operation) const;
+    qint64 percentileTime(const Operation operation, const qreal percentile) const;
+    static QString counterName(const Counter counter);
+    static QString operationName(const Operation operation);
+
+    static const int SAMPLE_CAPACITY = 1024;
+
+protected:
+    struct Timing {
+        qint64 count;
+        qint64 total;
+        qint64 maximum;
+        QList<qint64> samples;
+        int nextSample;
+    };
+
+    QList<qint64> counters_;
+    QList<Timing> timings_;
+};
+
+class QTileLayoutStatsScope
+{
+public:
+    QTileLayoutStatsScope(QTileLayout* const tileLayout, const QTileLayoutStats::Operation operation);
+    ~QTileLayoutStatsScope(void);
+
+protected:
+    QTileLayout* tileLayout_;
+    QTileLayoutStats::Operation operation_;
+    QElapsedTimer timer_;
+};
+
+#ifdef QTILELAYOUT_NO_STATS
+#define QTILELAYOUT_STATS_SCOPE(operation)
+#define QTILELAYOUT_STATS_COUNT(counter, amount) do { } while (0)
+#else
+#define QTILELAYOUT_STATS_SCOPE(operation) QTileLayoutStatsScope statsScope(this, QTileLayoutStats::operation)
+#define QTILELAYOUT_STATS_COUNT(counter, amount) \
+    do { \
+        if (this->statsEnabled_) { \
+            this->stats_.increment(QTileLayoutStats::counter, amount); \
+        } \
+    } while (0)
+#endif
+
+#endif // QTILELAYOUTSTATS_H
@@ -0,0 +1,48 @@
+#ifndef QTILEOCCUPANCY_H
+#define QTILEOCCUPANCY_H
+
+#include <QtCore/QList>
+#include <QtCore/QtAlgorithms>
+
+/*
+ * Occupancy of the tile grid: one bit per cell, packed row by row into 64-bit words.
+ * Rectangle queries use a 2D prefix-sum table that is rebuilt lazily after a change,
+ * or a word-parallel scan of the bitset when the table is stale and the area is small.
+ * The longest free run of every row is kept up to date on each change, so the free area search
+ * skips the row windows that contain a row without enough space, and runs on the AND of the
+ * free masks of the covered rows only for the remaining windows.
+ */
+class QTileOccupancy
+{
+public:
+    QTileOccupancy(void);
+    QTileOccupancy(const int rows, const int columns);
+    void resize(const int rows, const int columns);
+    void setArea(const int row, const int column, const int rowSpan, const int columnSpan, const bool filled);
+    bool isFilled(const int row, const int column) const;
+    bool isAreaEmpty(const int row, const int column, const int rowSpan, const int columnSpan) const;
+    int filledCount(const int row, const int column, const int rowSpan, const int columnSpan) const;
+    bool findFreeArea(const int rowSpan, const int columnSpan, int &row, int &column, const bool bestFit) const;
+    int rowCount(void) const;
+    int columnCount(void) const;
+
+protected:
+    void updatePrefixSums(void) const;
+    int longestFreeRun(const int row) const;
+    bool isAreaEmptyScan(const int row, const int column, const int rowSpan, const int columnSpan) const;
+    void freeMask(const int row, const int rowSpan, QList<quint64> &mask) const;
+    int nextBit(const QList<quint64> &mask, const int from, const bool value) const;
+    static quint64 wordMask(const int from, const int to);
+
+    int rows_;
+    int columns_;
+    int words_;
+    QList<quint64> bits_;
+    QList<int> longestRuns_;
+    mutable QList<int> prefixSums_;
+    mutable bool prefixSumsValid_;
+
+    static const int SCAN_WORD_LIMIT = 64;
+};
+
+#endif // QTILEOCCUPANCY_H
@@ -0,0 +1,99 @@
+#ifndef QTILETRACE_H
+#define QTILETRACE_H
+
+#include "QTileLayout_global.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QIODevice>
+#include <QtCore/QList>
+#include <QtCore/QRect>
+
+class QTileLayout;
+
+/*
+ * Trace of the high-level operations applied to a QTileLayout.
+ * A trace starts with the grid geometry, including the per-row and per-column size overrides (0 for the default
+ * size), and the widgets already placed, followed by one record per operation:
+ * operation, timestamp in nanoseconds since the start of the trace and up to 255 integer arguments.
+ * Widgets are identified by an integer id assigned when the layout first sees them.
+ * Group operations are preceded by selectWidgets records listing the selected widgets, split in chunks that fit
+ * in a record: the first argument is 0 for the chunk that starts the selection and 1 for the following ones.
+ */
+class QTILELAYOUT_EXPORT QTileTrace
+{
+public:
+    enum Operation {
+        AddWidget,
+        RemoveWidget,
+        ResizeTile,
+        DropWidget,
+        UpdateGlobalSize,
+        AddRows,
+        AddColumns,
+        RemoveRows,
+        RemoveColumns,
+        Compact,
+        MoveSelection,
+        ResizeSelection,
+        SelectWidgets,
+        SetRowHeight,
+        SetColumnWidth,
+        OperationCount
+    };
+
+    struct Header {
+        qint32 rows;
+        qint32 columns;
+        qint32 verticalSpan;
+        qint32 horizontalSpan;
+        qint32 verticalSpacing;
+        qint32 horizontalSpacing;
+        bool emptyCellMode;
+        QList<qint32> rowHeights;
+        QList<qint32> columnWidths;
+        QList<QPair<qint32, QRect>> widgets;
+    };
+
+    struct Record {
+        Operation operation;
+        qint64 timestamp;
+        QList<qint32> arguments;
+    };
+
+    QTileTrace(void);
+    void setDevice(QIODevice* const device);
+    QIODevice* device(void);
+    void writeHeader(const Header &header);
+    void writeRecord(const Operation operation, const QList<qint32> &arguments);
+    bool readHeader(Header &header);
+    bool readRecord(Record &record);
+    static QString operationName(const Operation operation);
+
+    static const quint32 MAGIC = 0x54544C51;
+    static const quint16 VERSION = 2;
+
+protected:
+    QDataStream stream_;
+    QElapsedTimer timer_;
+};
+
+class QTileTraceScope
+{
+public:
+    QTileTraceScope(QTileLayout* const tileLayout, const QTileTrace::Operation operation);
+    ~QTileTraceScope(void);
+    bool isRecording(void);
+    void record(const QList<qint32> &arguments);
+
+protected:
+    QTileLayout* tileLayout_;
+    QTileTrace::Operation operation_;
+    bool recording_;
+};
+
+#define QTILELAYOUT_TRACE(operation, ...) \
+    QTileTraceScope traceScope(this, QTileTrace::operation); \
+    if (traceScope.isRecording()) traceScope.record({__VA_ARGS__})
+
+#endif // QTILETRACE_H
@@ -4,8 +4,8 @@
 #include <QtWidgets/QWidget>
 #include <QtWidgets/QVBoxLayout>
 #include <QtGui/QDrag>
+#include <QtGui/QPainter>
 #include <QtCore/QMimeData>
-#include <QtCore/QJsonDocument>
 
 class QTileLayout;
 
@@ -13,58 +13,53 @@ class QTileWidget : public QWidget
 {
     Q_OBJECT
 public:
-    explicit QTileWidget(QTileLayout* const tileLayout, const int row, const int column, const int rowSpan, const int columnSpan, const int verticalSpan, const int horizontalSpan, QWidget* const parent = nullptr);
+    explicit QTileWidget(QTileLayout* const tileLayout, const int row, const int column, const int rowSpan, const int columnSpan, QWidget* const parent = nullptr);
     void addWidget(QWidget* const widget);
-    void updateSize(const int verticalSpan, const int horizontalSpan);
+    void updateSize(void);
     void updateSize(const int row, const int column, const int rowSpan, const int columnSpan);
-    void updateSize(const int row, const int column, const int rowSpan, const int columnSpan, const int verticalSpan, const int horizontalSpan);
-    void changeColor(const QPalette &palette);
     int getRow(void);
     int getColumn(void);
     int getRowSpan(void);
     int getColumnSpan(void);
+    QWidget* getWidget(void);
+    void removeWidget(void);
     bool isFilled(void);
+    bool isDragInProcess(void);
+    Qt::CursorShape cursorAt(const QPoint &position);
     void mouseMoveEvent(QMouseEvent *event);
     void mousePressEvent(QMouseEvent *event);
     void mouseReleaseEvent(QMouseEvent *event);
     void dragEnterEvent(QDragEnterEvent *event);
     void dropEvent(QDropEvent *event);
+    bool eventFilter(QObject *watched, QEvent *event);
+
+    static inline const QString MIME_TYPE_TILE_DATA = "TileData";
 
 protected:
     void updateSizeLimit(void);
     void prepareDropData(QMouseEvent* const event, QDrag &drag);
+    QPixmap dragPixmap(void);
     void dragAndDropProcess(QDrag &drag);
-    void removeWidget(void);
+    bool isLocked(void);
+    void updateCursor(const Qt::CursorShape cursor);
     int getResizeTileCount(const QPoint &position);
     int getResizeTileCount(const int x, const int y);
-    bool isDropPossible(QDragEnterEvent *event);
-    template <typename T>
-    bool canConvert(const QVariantMap &map, const QString &key);
 
     QTileLayout* tileLayout_;
-    QTileLayout* originTileLayout_;
     int row_;
     int column_;
     int rowSpan_;
     int columnSpan_;
-    int verticalSpan_;
-    int horizontalSpan_;
     int resizeMargin_;
     bool filled_;
     QWidget* widget_;
-    QPair<int, int>* lock_;
+    QPair<int, int> lock_;
+    int resizeExtent_;
     bool dragInProcess_;
     int currentTileCount_;
-    QPoint* mouseMovePos_;
-
-    const QString MIME_TYPE_TILE_DATA = "TileData";
-    const QString MIME_KEY_ID = "id";
-    const QString MIME_KEY_ROW = "row";
-    const QString MIME_KEY_COLUMN = "column";
-    const QString MIME_KEY_ROW_SPAN = "rowSpan";
-    const QString MIME_KEY_COLUMN_SPAN = "columnSpan";
-    const QString MIME_KEY_ROW_OFFSET = "rowOffset";
-    const QString MIME_KEY_COLUMN_OFFSET = "columnOffset";
+    QPoint mouseMovePos_;
+    bool mousePressed_;
+    qreal dragPixmapScale_;
 
 signals:
 
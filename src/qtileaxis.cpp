@@ -0,0 +1,144 @@
+#include "QTileLayout/qtileaxis.h"
+
+#include <algorithm>
+
+
+QTileAxis::QTileAxis(void)
+{
+    this->count_ = 0;
+    this->defaultSize_ = 0;
+    this->spacing_ = 0;
+    this->sizes_ = {};
+    this->fixedCount_ = 0;
+    this->fixedTotal_ = 0;
+    this->offsets_ = {};
+    this->offsetsValid_ = false;
+}
+
+void QTileAxis::resize(const int count)
+{
+    if (count == this->count_) {
+        return;
+    }
+
+    for (int index = count; index < this->count_; index++) {
+        this->setSize(index, 0);
+    }
+    this->sizes_.resize(count, 0);
+    this->count_ = count;
+    this->offsetsValid_ = false;
+}
+
+void QTileAxis::setDefaultSize(const int size)
+{
+    if (size != this->defaultSize_) {
+        this->defaultSize_ = size;
+        this->offsetsValid_ = false;
+    }
+}
+
+void QTileAxis::setSpacing(const int spacing)
+{
+    if (spacing != this->spacing_) {
+        this->spacing_ = spacing;
+        this->offsetsValid_ = false;
+    }
+}
+
+bool QTileAxis::setSize(const int index, const int size)
+{
+    assert((index >= 0) && (index < this->count_) && (size >= 0));
+    int &current = this->sizes_[index];
+    if (current == size) {
+        return false;
+    }
+
+    this->fixedCount_ += ((size > 0)? 1 : 0) - ((current > 0)? 1 : 0);
+    this->fixedTotal_ += size - current;
+    current = size;
+    this->offsetsValid_ = false;
+    return true;
+}
+
+int QTileAxis::size(const int index) const
+{
+    return this->isSizeFixed(index)? this->sizes_[index] : this->defaultSize_;
+}
+
+bool QTileAxis::isSizeFixed(const int index) const
+{
+    return (index >= 0) && (index < this->count_) && (this->sizes_[index] > 0);
+}
+
+int QTileAxis::offset(const int index) const
+{
+    if (!this->offsetsValid_) {
+        this->updateOffsets();
+    }
+
+    if (index <= this->count_) {
+        return this->offsets_[qMax(index, 0)];
+    }
+    return this->offsets_[this->count_] + (index - this->count_) * (this->defaultSize_ + this->spacing_);
+}
+
+int QTileAxis::extent(const int index, const int span) const
+{
+    return this->offset(index + span) - this->offset(index) - this->spacing_;
+}
+
+int QTileAxis::indexAt(const int position) const
+{
+    if ((position < 0) || (this->count_ == 0)) {
+        return -1;
+    }
+    if (!this->offsetsValid_) {
+        this->updateOffsets();
+    }
+
+    auto itr = std::upper_bound(this->offsets_.constBegin(), this->offsets_.constEnd(), position);
+    int index = int(itr - this->offsets_.constBegin()) - 1;
+    return (index < this->count_)? index : -1;
+}
+
+int QTileAxis::boundaryAt(const int position) const
+{
+    if (position <= 0) {
+        return 0;
+    }
+    if (position >= this->offset(this->count_)) {
+        return this->count_;
+    }
+
+    int index = this->indexAt(position);
+    return (position - this->offsets_[index] < this->size(index) / 2)? index : index + 1;
+}
+
+int QTileAxis::count(void) const
+{
+    return this->count_;
+}
+
+int QTileAxis::fixedCount(void) const
+{
+    return this->fixedCount_;
+}
+
+int QTileAxis::fixedTotal(void) const
+{
+    return this->fixedTotal_;
+}
+
+QList<int> QTileAxis::fixedSizes(void) const
+{
+    return this->sizes_;
+}
+
+void QTileAxis::updateOffsets(void) const
+{
+    this->offsets_ = QList<int>(this->count_ + 1, 0);
+    for (int index = 0; index < this->count_; index++) {
+        this->offsets_[index + 1] = this->offsets_[index] + this->size(index) + this->spacing_;
+    }
+    this->offsetsValid_ = true;
+}
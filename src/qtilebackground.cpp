@@ -0,0 +1,177 @@
+#include "QTileLayout/qtilelayout.h"
+#include "QTileLayout/qtilewidget.h"
+#include "QTileLayout/qtilebackground.h"
+
+
+QTileBackground::QTileBackground(QTileLayout* const tileLayout, QWidget* const parent)
+    : QWidget{parent}
+{
+    this->tileLayout_ = tileLayout;
+    this->rows_ = 0;
+    this->columns_ = 0;
+    this->cellColors_ = {};
+    this->selectedAreas_ = {};
+    this->selectionColor_ = QColor();
+    this->dragRow_ = -1;
+    this->dragColumn_ = -1;
+    this->dropPossible_ = false;
+
+    this->setAcceptDrops(true);
+}
+
+void QTileBackground::resizeGrid(const int rows, const int columns, const QColor &color)
+{
+    this->rows_ = rows;
+    this->columns_ = columns;
+    this->cellColors_ = QList<QColor>(rows * columns, color);
+    this->update();
+}
+
+void QTileBackground::setCellColor(const int row, const int column, const QColor &color)
+{
+    QColor &cellColor = this->cellColors_[row * this->columns_ + column];
+    if (cellColor != color) {
+        cellColor = color;
+        this->update(this->cellRect(row, column));
+    }
+}
+
+void QTileBackground::setSelection(const QList<QRect> &areas, const QColor &color)
+{
+    if ((areas == this->selectedAreas_) && (color == this->selectionColor_)) {
+        return;
+    }
+    this->selectedAreas_ = areas;
+    this->selectionColor_ = color;
+    this->update();
+}
+
+QRect QTileBackground::cellRect(const int row, const int column)
+{
+    return this->areaRect(row, column, 1, 1);
+}
+
+QRect QTileBackground::areaRect(const int row, const int column, const int rowSpan, const int columnSpan)
+{
+    const QTileAxis &rowAxis = this->tileLayout_->rowAxis();
+    const QTileAxis &columnAxis = this->tileLayout_->columnAxis();
+    return QRect(
+        columnAxis.offset(column), rowAxis.offset(row),
+        columnAxis.extent(column, columnSpan), rowAxis.extent(row, rowSpan)
+        );
+}
+
+QRect QTileBackground::cellsIn(const QRect &rect)
+{
+    if ((rect.bottom() < 0) || (rect.right() < 0) || (this->rows_ == 0) || (this->columns_ == 0)) {
+        return QRect();
+    }
+
+    const QTileAxis &rowAxis = this->tileLayout_->rowAxis();
+    const QTileAxis &columnAxis = this->tileLayout_->columnAxis();
+    int fromRow = rowAxis.indexAt(qMax(0, rect.top()));
+    int fromColumn = columnAxis.indexAt(qMax(0, rect.left()));
+    if ((fromRow < 0) || (fromColumn < 0)) {
+        return QRect();
+    }
+
+    int toRow = rowAxis.indexAt(rect.bottom());
+    int toColumn = columnAxis.indexAt(rect.right());
+    toRow = qMin((toRow < 0)? this->rows_ - 1 : toRow, this->rows_ - 1);
+    toColumn = qMin((toColumn < 0)? this->columns_ - 1 : toColumn, this->columns_ - 1);
+    return QRect(fromColumn, fromRow, toColumn - fromColumn + 1, toRow - fromRow + 1);
+}
+
+bool QTileBackground::cellAt(const QPoint &position, int &row, int &column)
+{
+    row = this->tileLayout_->rowAxis().indexAt(position.y());
+    column = this->tileLayout_->columnAxis().indexAt(position.x());
+    return (row >= 0) && (column >= 0) && (row < this->rows_) && (column < this->columns_);
+}
+
+void QTileBackground::dragEnterEvent(QDragEnterEvent *event)
+{
+    this->dragRow_ = -1;
+    this->dragColumn_ = -1;
+    this->dropPossible_ = false;
+
+    if (
+        this->tileLayout_->dragAndDrop &&
+        event->mimeData()->hasFormat(QTileWidget::MIME_TYPE_TILE_DATA)
+        ) {
+        this->updateDropTarget(event);
+    }
+}
+
+void QTileBackground::dragMoveEvent(QDragMoveEvent *event)
+{
+    this->updateDropTarget(event);
+}
+
+void QTileBackground::dropEvent(QDropEvent *event)
+{
+    int row, column;
+    if (
+        !this->cellAt(event->position().toPoint(), row, column) ||
+        !this->tileLayout_->isDropPossible(event->mimeData(), row, column)
+        ) {
+        event->ignore();
+        return;
+    }
+
+    this->tileLayout_->dropWidget(event->mimeData(), row, column);
+    event->acceptProposedAction();
+}
+
+bool QTileBackground::event(QEvent *event)
+{
+    if (event->type() == QEvent::ParentChange) {
+        this->lower();
+    }
+    return Super::event(event);
+}
+
+void QTileBackground::paintEvent(QPaintEvent *event)
+{
+    if (this->cellColors_.isEmpty()) {
+        return;
+    }
+
+    QPainter painter(this);
+    QRect cells = this->cellsIn(event->rect());
+
+    for (int row = cells.top(); row <= cells.bottom(); row++) {
+        for (int column = cells.left(); column <= cells.right(); column++) {
+            painter.fillRect(this->cellRect(row, column), this->cellColors_[row * this->columns_ + column]);
+        }
+    }
+
+    int horizontalMargin = this->tileLayout_->horizontalSpacing() / 2;
+    int verticalMargin = this->tileLayout_->verticalSpacing() / 2;
+    painter.setPen(QPen(this->selectionColor_, 2));
+    for (const QRect &area : this->selectedAreas_) {
+        QRect outline = this->areaRect(area.y(), area.x(), area.height(), area.width());
+        painter.drawRect(outline.adjusted(-horizontalMargin, -verticalMargin, horizontalMargin, verticalMargin));
+    }
+}
+
+void QTileBackground::updateDropTarget(QDragMoveEvent *event)
+{
+    int row, column;
+    if (!this->cellAt(event->position().toPoint(), row, column)) {
+        this->dragRow_ = -1;
+        this->dragColumn_ = -1;
+        this->dropPossible_ = false;
+    } else if ((row != this->dragRow_) || (column != this->dragColumn_)) {
+        this->dragRow_ = row;
+        this->dragColumn_ = column;
+        this->dropPossible_ = this->tileLayout_->isDropPossible(event->mimeData(), row, column);
+    }
+
+    if (this->dropPossible_) {
+        event->acceptProposedAction();
+    } else {
+        event->setDropAction(Qt::DropAction::IgnoreAction);
+        event->accept();
+    }
+}
@@ -0,0 +1,73 @@
+#include "QTileLayout/qtiledropdata.h"
+#include "QTileLayout/qtilewidget.h"
+#include <QtCore/QtEndian>
+
+static const QMimeData* cachedMimeData = nullptr;
+static QTileDropData cachedData;
+static bool cachedValid = false;
+
+
+QTileDropData::QTileDropData(void)
+{
+    this->id = QUuid();
+    this->row = 0;
+    this->column = 0;
+    this->rowSpan = 0;
+    this->columnSpan = 0;
+    this->rowOffset = 0;
+    this->columnOffset = 0;
+}
+
+QByteArray QTileDropData::encode(void) const
+{
+    QByteArray data(this->SIZE, 0);
+    data.replace(8, 16, this->id.toRfc4122());
+    char *buffer = data.data();
+
+    qToLittleEndian<quint32>(this->MAGIC, buffer);
+    qToLittleEndian<quint16>(this->VERSION, buffer + 4);
+    qToLittleEndian<qint32>(this->row, buffer + 24);
+    qToLittleEndian<qint32>(this->column, buffer + 28);
+    qToLittleEndian<qint32>(this->rowSpan, buffer + 32);
+    qToLittleEndian<qint32>(this->columnSpan, buffer + 36);
+    qToLittleEndian<qint32>(this->rowOffset, buffer + 40);
+    qToLittleEndian<qint32>(this->columnOffset, buffer + 44);
+    return data;
+}
+
+bool QTileDropData::decode(const QByteArray &data)
+{
+    if (data.size() != this->SIZE) return false;
+
+    const char *buffer = data.constData();
+    if (qFromLittleEndian<quint32>(buffer) != this->MAGIC) return false;
+    if (qFromLittleEndian<quint16>(buffer + 4) != this->VERSION) return false;
+
+    const uchar *uuid = reinterpret_cast<const uchar*>(buffer + 8);
+    this->id = QUuid(
+        qFromBigEndian<quint32>(uuid), qFromBigEndian<quint16>(uuid + 4), qFromBigEndian<quint16>(uuid + 6),
+        uuid[8], uuid[9], uuid[10], uuid[11], uuid[12], uuid[13], uuid[14], uuid[15]
+        );
+    this->row = qFromLittleEndian<qint32>(buffer + 24);
+    this->column = qFromLittleEndian<qint32>(buffer + 28);
+    this->rowSpan = qFromLittleEndian<qint32>(buffer + 32);
+    this->columnSpan = qFromLittleEndian<qint32>(buffer + 36);
+    this->rowOffset = qFromLittleEndian<qint32>(buffer + 40);
+    this->columnOffset = qFromLittleEndian<qint32>(buffer + 44);
+    return (this->rowSpan > 0) && (this->columnSpan > 0);
+}
+
+const QTileDropData* QTileDropData::fromMimeData(const QMimeData* const mimeData)
+{
+    if (mimeData != cachedMimeData) {
+        cachedMimeData = mimeData;
+        cachedValid = cachedData.decode(mimeData->data(QTileWidget::MIME_TYPE_TILE_DATA));
+    }
+    return cachedValid ? &cachedData : nullptr;
+}
+
+void QTileDropData::clearCache(void)
+{
+    cachedMimeData = nullptr;
+    cachedValid = false;
+}
@@ -0,0 +1,296 @@
+#include "QTileLayout/qtilegrid.h"
+
+#include <algorithm>
+
+
+QTileGrid::QTileGrid(void)
+    : QTileGrid(0, 0)
+{
+}
+
+QTileGrid::QTileGrid(const int rows, const int columns)
+{
+    this->rows_ = rows;
+    this->columns_ = columns;
+    this->occupancy_ = QTileOccupancy(rows, columns);
+    this->cellKeys_ = QList<Key>(rows * columns, 0);
+    this->areas_ = {};
+}
+
+void QTileGrid::resize(const int rows, const int columns)
+{
+    assert((rows >= 0) && (columns >= 0));
+    QList<Key> cellKeys(rows * columns, 0);
+    for (int row = 0; row < qMin(rows, this->rows_); row++) {
+        for (int column = 0; column < qMin(columns, this->columns_); column++) {
+            cellKeys[row * columns + column] = this->cellKeys_[row * this->columns_ + column];
+        }
+    }
+    for (auto itr = this->areas_.constBegin(); itr != this->areas_.constEnd(); ++itr) {
+        assert(QRect(0, 0, columns, rows).contains(itr.value()));
+    }
+
+    this->rows_ = rows;
+    this->columns_ = columns;
+    this->occupancy_.resize(rows, columns);
+    this->cellKeys_ = cellKeys;
+}
+
+int QTileGrid::rowCount(void) const
+{
+    return this->rows_;
+}
+
+int QTileGrid::columnCount(void) const
+{
+    return this->columns_;
+}
+
+bool QTileGrid::isFilled(const int row, const int column) const
+{
+    return this->occupancy_.isFilled(row, column);
+}
+
+bool QTileGrid::isAreaEmpty(const int row, const int column, const int rowSpan, const int columnSpan) const
+{
+    if ((row < 0) || (column < 0) || (rowSpan <= 0) || (columnSpan <= 0) || (row + rowSpan > this->rows_) || (column + columnSpan > this->columns_)) {
+        return false;
+    }
+    return this->occupancy_.isAreaEmpty(row, column, rowSpan, columnSpan);
+}
+
+bool QTileGrid::isAreaFree(const Key key, const QRect &area) const
+{
+    if (!area.isValid() || !QRect(0, 0, this->columns_, this->rows_).contains(area)) {
+        return false;
+    }
+
+    QRect own = this->areas_.value(key).intersected(area);
+    if (own.isEmpty()) {
+        return this->occupancy_.isAreaEmpty(area.y(), area.x(), area.height(), area.width());
+    }
+
+    const QRect strips[4] = {
+        QRect(area.left(), area.top(), area.width(), own.top() - area.top()),
+        QRect(area.left(), own.bottom() + 1, area.width(), area.bottom() - own.bottom()),
+        QRect(area.left(), own.top(), own.left() - area.left(), own.height()),
+        QRect(own.right() + 1, own.top(), area.right() - own.right(), own.height())
+    };
+    for (const QRect &strip : strips) {
+        if (!strip.isEmpty() && !this->occupancy_.isAreaEmpty(strip.y(), strip.x(), strip.height(), strip.width())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool QTileGrid::findFreeArea(const int rowSpan, const int columnSpan, int &row, int &column, const bool bestFit) const
+{
+    return this->occupancy_.findFreeArea(rowSpan, columnSpan, row, column, bestFit);
+}
+
+bool QTileGrid::contains(const Key key) const
+{
+    return this->areas_.contains(key);
+}
+
+QRect QTileGrid::area(const Key key) const
+{
+    return this->areas_.value(key);
+}
+
+QTileGrid::Key QTileGrid::keyAt(const int row, const int column) const
+{
+    return this->cellKeys_[row * this->columns_ + column];
+}
+
+QList<QTileGrid::Key> QTileGrid::keys(void) const
+{
+    return this->areas_.keys();
+}
+
+int QTileGrid::size(void) const
+{
+    return this->areas_.size();
+}
+
+bool QTileGrid::place(const Key key, const QRect &area)
+{
+    assert(key != 0);
+    if (this->areas_.contains(key) || !this->isAreaEmpty(area.y(), area.x(), area.height(), area.width())) {
+        return false;
+    }
+
+    this->areas_.insert(key, area);
+    this->setArea(key, area, true);
+    return true;
+}
+
+bool QTileGrid::move(const Key key, const QRect &area)
+{
+    if (!this->areas_.contains(key) || !this->isAreaFree(key, area)) {
+        return false;
+    }
+
+    this->setArea(key, this->areas_[key], false);
+    this->areas_[key] = area;
+    this->setArea(key, area, true);
+    return true;
+}
+
+bool QTileGrid::move(const QHash<Key, QRect> &areas)
+{
+    for (auto itr = areas.constBegin(); itr != areas.constEnd(); ++itr) {
+        if (!this->areas_.contains(itr.key())) {
+            return false;
+        }
+    }
+    for (auto itr = areas.constBegin(); itr != areas.constEnd(); ++itr) {
+        this->setArea(itr.key(), this->areas_[itr.key()], false);
+    }
+
+    auto placed = areas.constBegin();
+    while (placed != areas.constEnd()) {
+        const QRect &area = placed.value();
+        if (!this->isAreaEmpty(area.y(), area.x(), area.height(), area.width())) {
+            break;
+        }
+        this->setArea(placed.key(), area, true);
+        ++placed;
+    }
+
+    if (placed == areas.constEnd()) {
+        for (auto itr = areas.constBegin(); itr != areas.constEnd(); ++itr) {
+            this->areas_[itr.key()] = itr.value();
+        }
+        return true;
+    }
+    for (auto itr = areas.constBegin(); itr != placed; ++itr) {
+        this->setArea(itr.key(), itr.value(), false);
+    }
+    for (auto itr = areas.constBegin(); itr != areas.constEnd(); ++itr) {
+        this->setArea(itr.key(), this->areas_[itr.key()], true);
+    }
+    return false;
+}
+
+void QTileGrid::remove(const Key key)
+{
+    if (this->areas_.contains(key)) {
+        this->setArea(key, this->areas_.take(key), false);
+    }
+}
+
+int QTileGrid::freeExtent(const QRect &area, const QPair<int, int> &direction) const
+{
+    bool horizontal = (direction.first != 0);
+    int sign = direction.first + direction.second;
+    int limit = (sign < 0) ? (horizontal ? area.left() : area.top())
+                           : (horizontal ? this->columns_ - area.right() - 1 : this->rows_ - area.bottom() - 1);
+
+    int extent = 0;
+    for (; extent < limit; extent++) {
+        QRect strip = horizontal
+            ? QRect((sign > 0) ? area.right() + 1 + extent : area.left() - 1 - extent, area.y(), 1, area.height())
+            : QRect(area.x(), (sign > 0) ? area.bottom() + 1 + extent : area.top() - 1 - extent, area.width(), 1);
+        if (!this->occupancy_.isAreaEmpty(strip.y(), strip.x(), strip.height(), strip.width())) {
+            break;
+        }
+    }
+    return extent;
+}
+
+QRect QTileGrid::resizedArea(const QRect &area, const QPair<int, int> &direction, const int tileCount) const
+{
+    return QTileGrid::resizedArea(area, direction, tileCount, this->freeExtent(area, direction));
+}
+
+QRect QTileGrid::resizedArea(const QRect &area, const QPair<int, int> &direction, const int tileCount, const int freeExtent)
+{
+    int sign = direction.first + direction.second;
+    int span = (direction.first != 0) ? area.width() : area.height();
+    int count = (tileCount * sign > 0) ? qMin(qAbs(tileCount), freeExtent) : -qMin(qAbs(tileCount), span - 1);
+
+    QRect resized = area;
+    if (direction.first == 1) {
+        resized.setRight(area.right() + count);
+    } else if (direction.first == -1) {
+        resized.setLeft(area.left() - count);
+    } else if (direction.second == 1) {
+        resized.setBottom(area.bottom() + count);
+    } else {
+        resized.setTop(area.top() - count);
+    }
+    return resized;
+}
+
+bool QTileGrid::compact(const CompactionMode mode)
+{
+    bool up = (mode == CompactUp);
+    QList<Key> keys = this->areas_.keys();
+    std::sort(keys.begin(), keys.end(), [this, up](const Key a, const Key b) {
+        const QRect &areaA = this->areas_[a];
+        const QRect &areaB = this->areas_[b];
+        if (up) {
+            return QPair<int, int>(areaA.y(), areaA.x()) < QPair<int, int>(areaB.y(), areaB.x());
+        }
+        return QPair<int, int>(areaA.x(), areaA.y()) < QPair<int, int>(areaB.x(), areaB.y());
+    });
+
+    QList<int> skyline(up ? this->columns_ : this->rows_, 0);
+    QList<QPair<Key, QRect>> moves;
+    for (Key key : keys) {
+        const QRect &area = this->areas_[key];
+        int from = up ? area.x() : area.y();
+        int span = up ? area.width() : area.height();
+        int depth = up ? area.height() : area.width();
+
+        int position = 0;
+        for (int index = from; index < from + span; index++) {
+            position = qMax(position, skyline[index]);
+        }
+        for (int index = from; index < from + span; index++) {
+            skyline[index] = position + depth;
+        }
+
+        if (position != (up ? area.y() : area.x())) {
+            moves.append({key, up ? QRect(area.x(), position, area.width(), area.height())
+                                  : QRect(position, area.y(), area.width(), area.height())});
+        }
+    }
+
+    for (const QPair<Key, QRect> &move : moves) {
+        this->setArea(move.first, this->areas_[move.first], false);
+    }
+    for (const QPair<Key, QRect> &move : moves) {
+        this->areas_[move.first] = move.second;
+        this->setArea(move.first, move.second, true);
+    }
+    return !moves.isEmpty();
+}
+
+QHash<QTileGrid::Key, QRect> QTileGrid::changedAreas(const QTileGrid &grid) const
+{
+    QHash<Key, QRect> changes;
+    for (auto itr = this->areas_.constBegin(); itr != this->areas_.constEnd(); ++itr) {
+        if (grid.areas_.value(itr.key()) != itr.value()) {
+            changes.insert(itr.key(), itr.value());
+        }
+    }
+    for (auto itr = grid.areas_.constBegin(); itr != grid.areas_.constEnd(); ++itr) {
+        if (!this->areas_.contains(itr.key())) {
+            changes.insert(itr.key(), QRect());
+        }
+    }
+    return changes;
+}
+
+void QTileGrid::setArea(const Key key, const QRect &area, const bool filled)
+{
+    this->occupancy_.setArea(area.y(), area.x(), area.height(), area.width(), filled);
+    for (int row = area.top(); row <= area.bottom(); row++) {
+        for (int column = area.left(); column <= area.right(); column++) {
+            this->cellKeys_[row * this->columns_ + column] = filled ? key : 0;
+        }
+    }
+}
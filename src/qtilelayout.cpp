@@ -1,16 +1,19 @@
 #include "QTileLayout/qtilelayout.h"
 #include "QTileLayout/qtilewidget.h"
+#include "QTileLayout/qtilebackground.h"
+#include "QTileLayout/qtiledropdata.h"
+#include <algorithm>
 
-QTileLayout::QTileLayout(const int rows, const int columns, const int verticalSpan, const int horizontalSpan, const int verticalSpacing, const int horizontalSpacing)
+QTileLayout::QTileLayout(const int rows, const int columns, const int verticalSpan, const int horizontalSpan, const int verticalSpacing, const int horizontalSpacing, const bool emptyCellMode)
     :   QGridLayout(nullptr)
 {
-    this->init(rows, columns, verticalSpan, horizontalSpan, verticalSpacing, horizontalSpacing);
+    this->init(rows, columns, verticalSpan, horizontalSpan, verticalSpacing, horizontalSpacing, emptyCellMode);
 }
 
-QTileLayout::QTileLayout(QWidget* const parent, const int rows, const int columns, const int verticalSpan, const int horizontalSpan, const int verticalSpacing, const int horizontalSpacing)
+QTileLayout::QTileLayout(QWidget* const parent, const int rows, const int columns, const int verticalSpan, const int horizontalSpan, const int verticalSpacing, const int horizontalSpacing, const bool emptyCellMode)
     :   QGridLayout(parent)
 {
-    this->init(rows, columns, verticalSpan, horizontalSpan, verticalSpacing, horizontalSpacing);
+    this->init(rows, columns, verticalSpan, horizontalSpan, verticalSpacing, horizontalSpacing, emptyCellMode);
 }
 
 void QTileLayout::addWidget(QWidget* const widget, const int row, const int column)
@@ -19,38 +22,343 @@ void QTileLayout::addWidget(QWidget* const widget, const int row, const int colu
 }
 
 void QTileLayout::addWidget(QWidget* const widget, const int row, const int column, const int rowSpan, const int columnSpan){
-    assert(!this->widgets_.contains(widget));
+    QTILELAYOUT_STATS_SCOPE(AddWidget);
+    QTILELAYOUT_TRACE(AddWidget, this->traceWidgetId(widget), row, column, rowSpan, columnSpan);
+    assert(!this->widgetTiles_.contains(widget));
     assert(this->isAreaEmpty(row, column, rowSpan, columnSpan));
 
-    QTileWidget *tile = this->tileMap_[row][column];
-    this->widgets_.append(widget);
-    this->tiles_.append(tile);
+    this->placeWidget(widget, row, column, rowSpan, columnSpan);
+}
 
-    if ((rowSpan > 1) || (columnSpan > 1)) {
-        QSet<QPair<int, int>> tileToMerge = {};
-        bool ini = true;
-        for (int r = row; r < row + rowSpan; r++) {
-            for (int c = column; c < column + columnSpan; c++) {
-                if (ini == true) {
-                    ini = false;
-                } else {
-                    tileToMerge.insert(QPair<int, int>(r, c));
+bool QTileLayout::addWidgets(const QList<QPair<QWidget*, QRect>> &placements)
+{
+    QTILELAYOUT_STATS_SCOPE(AddWidgets);
+
+    QTileGrid grid = this->grid_;
+    for (const QPair<QWidget*, QRect> &placement : placements) {
+        if (
+            (placement.first == nullptr) ||
+            this->widgetTiles_.contains(placement.first) ||
+            !grid.place(this->gridKey(placement.first), placement.second)
+            ) {
+            return false;
+        }
+    }
+
+    this->beginUpdate();
+    for (const QPair<QWidget*, QRect> &placement : placements) {
+        const QRect &cells = placement.second;
+        QTILELAYOUT_TRACE(AddWidget, this->traceWidgetId(placement.first), cells.y(), cells.x(), cells.height(), cells.width());
+        this->placeWidget(placement.first, cells.y(), cells.x(), cells.height(), cells.width());
+    }
+    this->endUpdate();
+    return true;
+}
+
+QWidget* QTileLayout::addWidgetFactory(const std::function<QWidget*(void)> &factory, const int row, const int column)
+{
+    return this->addWidgetFactory(factory, row, column, 1, 1);
+}
+
+QWidget* QTileLayout::addWidgetFactory(const std::function<QWidget*(void)> &factory, const int row, const int column, const int rowSpan, const int columnSpan)
+{
+    assert(factory);
+
+    QWidget *placeholder = new QWidget();
+    this->addWidget(placeholder, row, column, rowSpan, columnSpan);
+    this->widgetFactories_.insert(placeholder, factory);
+    this->pendingFactories_.append(placeholder);
+    placeholder->installEventFilter(this);
+    this->factoryTimer_->start();
+    return placeholder;
+}
+
+int QTileLayout::pendingWidgetCount(void)
+{
+    return this->pendingFactories_.size();
+}
+
+bool QTileLayout::findFreeArea(const int rowSpan, const int columnSpan, int &row, int &column)
+{
+    return this->grid_.findFreeArea(rowSpan, columnSpan, row, column, false);
+}
+
+bool QTileLayout::findBestFreeArea(const int rowSpan, const int columnSpan, int &row, int &column)
+{
+    return this->grid_.findFreeArea(rowSpan, columnSpan, row, column, true);
+}
+
+bool QTileLayout::addWidgetAnywhere(QWidget* const widget, const int rowSpan, const int columnSpan, const bool bestFit)
+{
+    int row, column;
+    if (!this->grid_.findFreeArea(rowSpan, columnSpan, row, column, bestFit)) {
+        return false;
+    }
+    this->addWidget(widget, row, column, rowSpan, columnSpan);
+    return true;
+}
+
+void QTileLayout::compact(const CompactionMode mode)
+{
+    QTILELAYOUT_STATS_SCOPE(Compact);
+    QTILELAYOUT_TRACE(Compact, mode);
+
+    QTileGrid grid = this->grid_;
+    if (grid.compact(QTileGrid::CompactionMode(mode))) {
+        this->applyGrid(grid);
+    }
+}
+
+QTileGrid QTileLayout::grid(void)
+{
+    return this->grid_;
+}
+
+bool QTileLayout::applyGrid(const QTileGrid &grid)
+{
+    QTILELAYOUT_STATS_SCOPE(ApplyGrid);
+    if ((grid.rowCount() != this->rows) || (grid.columnCount() != this->columns)) {
+        return false;
+    }
+
+    QHash<QTileGrid::Key, QRect> changes = grid.changedAreas(this->grid_);
+    QList<QPair<QTileWidget*, QRect>> moves;
+    for (auto itr = changes.constBegin(); itr != changes.constEnd(); ++itr) {
+        if (!this->grid_.contains(itr.key()) || itr.value().isNull()) {
+            return false;
+        }
+        moves.append({this->widgetTiles_[reinterpret_cast<QWidget*>(itr.key())], itr.value()});
+    }
+    if (moves.isEmpty()) {
+        return true;
+    }
+
+    this->beginUpdate();
+
+    for (const QPair<QTileWidget*, QRect> &move : moves) {
+        QTileWidget *tile = move.first;
+        for (int r = tile->getRow(); r < tile->getRow() + tile->getRowSpan(); r++) {
+            for (int c = tile->getColumn(); c < tile->getColumn() + tile->getColumnSpan(); c++) {
+                this->tileMap_[r][c] = nullptr;
+            }
+        }
+    }
+
+    QList<QRect> vacatedAreas;
+    for (const QPair<QTileWidget*, QRect> &move : moves) {
+        QTileWidget *tile = move.first;
+        const QRect &cells = move.second;
+        vacatedAreas.append(QRect(tile->getColumn(), tile->getRow(), tile->getColumnSpan(), tile->getRowSpan()));
+
+        for (int r = cells.top(); r <= cells.bottom(); r++) {
+            for (int c = cells.left(); c <= cells.right(); c++) {
+                QTileWidget *placeholder = this->tileMap_[r][c];
+                if (placeholder != nullptr) {
+                    QRect area(placeholder->getColumn(), placeholder->getRow(), placeholder->getColumnSpan(), placeholder->getRowSpan());
+                    for (int pr = area.top(); pr <= area.bottom(); pr++) {
+                        for (int pc = area.left(); pc <= area.right(); pc++) {
+                            this->tileMap_[pr][pc] = nullptr;
+                        }
+                    }
+                    vacatedAreas.append(area);
+                    this->releaseTile(placeholder);
+                }
+                this->tileMap_[r][c] = tile;
+            }
+        }
+        if ((this->scrollArea_ == nullptr) || this->materializedTiles_.contains(tile)) {
+            this->gridMoveWidget(tile, cells.y(), cells.x(), cells.height(), cells.width());
+        }
+        tile->updateSize(cells.y(), cells.x(), cells.height(), cells.width());
+    }
+
+    if (!this->emptyCellMode) {
+        for (const QRect &cells : vacatedAreas) {
+            for (int r = cells.top(); r <= cells.bottom(); r++) {
+                for (int c = cells.left(); c <= cells.right(); c++) {
+                    if (this->tileMap_[r][c] == nullptr) {
+                        this->createTile(r, c, true);
+                    }
                 }
             }
         }
-        this->mergeTiles(tile, row, column, rowSpan, columnSpan, tileToMerge);
     }
 
-    widget->setMouseTracking(true);
+    this->grid_ = grid;
+    this->resetTilesColor();
+    this->changeTilesColor(this->colorIdle);
+    this->endUpdate();
+    this->updateVirtualization();
+    this->updateSelectionOutline();
+    emit this->tilesRearranged();
+    return true;
+}
+
+void QTileLayout::setSelected(QWidget* const widget, const bool selected)
+{
+    assert(this->widgetTiles_.contains(widget));
+    if (selected == this->selection_.contains(widget)) {
+        return;
+    }
+
+    if (selected) {
+        this->selection_.append(widget);
+    } else {
+        this->selection_.removeOne(widget);
+    }
+    this->updateSelectionOutline();
+    emit this->selectionChanged();
+}
+
+bool QTileLayout::isSelected(QWidget* const widget)
+{
+    return this->selection_.contains(widget);
+}
+
+QList<QWidget*> QTileLayout::selectedWidgets(void)
+{
+    return this->selection_;
+}
+
+void QTileLayout::clearSelection(void)
+{
+    if (!this->selection_.isEmpty()) {
+        this->selection_ = {};
+        this->updateSelectionOutline();
+        emit this->selectionChanged();
+    }
+}
+
+bool QTileLayout::moveSelection(const int rowOffset, const int columnOffset)
+{
+    QTILELAYOUT_STATS_SCOPE(MoveSelection);
+    QTileTraceScope traceScope(this, QTileTrace::MoveSelection);
+    if (traceScope.isRecording()) {
+        this->traceSelection();
+        traceScope.record({rowOffset, columnOffset});
+    }
+
+    QHash<QTileGrid::Key, QRect> areas;
+    for (QWidget *widget : this->selection_) {
+        QTileGrid::Key key = this->gridKey(widget);
+        areas.insert(key, this->grid_.area(key).translated(columnOffset, rowOffset));
+    }
+    return this->applySelection(areas);
+}
+
+bool QTileLayout::resizeSelection(QPair<int, int>* const direction, const int tileCount)
+{
+    QTILELAYOUT_STATS_SCOPE(ResizeSelection);
+    QTileTraceScope traceScope(this, QTileTrace::ResizeSelection);
+    if (traceScope.isRecording()) {
+        this->traceSelection();
+        traceScope.record({direction->first, direction->second, tileCount});
+    }
+
+    QHash<QTileGrid::Key, QRect> areas;
+    for (QWidget *widget : this->selection_) {
+        QTileGrid::Key key = this->gridKey(widget);
+        areas.insert(key, QTileGrid::resizedArea(this->grid_.area(key), *direction, tileCount, qAbs(tileCount)));
+    }
+    return this->applySelection(areas);
+}
+
+bool QTileLayout::applySelection(const QHash<QTileGrid::Key, QRect> &areas)
+{
+    QTileGrid grid = this->grid_;
+    if (!grid.move(areas)) {
+        return false;
+    }
+    return this->applyGrid(grid);
+}
+
+qint32 QTileLayout::traceWidgetId(QWidget* const widget)
+{
+    if (!this->traceWidgetIds_.contains(widget)) {
+        this->traceWidgetIds_.insert(widget, this->traceWidgetIds_.size());
+    }
+    return this->traceWidgetIds_[widget];
+}
+
+void QTileLayout::traceSelection(void)
+{
+    QList<qint32> arguments = {0};
+    for (QWidget *widget : this->selection_) {
+        if (arguments.size() == 255) {
+            this->trace_.writeRecord(QTileTrace::SelectWidgets, arguments);
+            arguments = {1};
+        }
+        arguments.append(this->traceWidgetId(widget));
+    }
+    this->trace_.writeRecord(QTileTrace::SelectWidgets, arguments);
+}
+
+void QTileLayout::updateSelectionOutline(void)
+{
+    QList<QRect> areas;
+    for (QWidget *widget : this->selection_) {
+        areas.append(this->grid_.area(this->gridKey(widget)));
+    }
+    this->background_->setSelection(areas, this->colorSelected);
+}
+
+void QTileLayout::placeWidget(QWidget* const widget, const int row, const int column, const int rowSpan, const int columnSpan)
+{
+    QTileWidget *tile = nullptr;
+    if (this->emptyCellMode || (this->tileMap_[row][column] == nullptr)) {
+        tile = this->createTile(row, column, rowSpan, columnSpan, true);
+    } else {
+        tile = this->tileMap_[row][column];
+        if ((rowSpan > 1) || (columnSpan > 1)) {
+            for (int r = row; r < row + rowSpan; r++) {
+                for (int c = column; c < column + columnSpan; c++) {
+                    if (this->tileMap_[r][c] != tile) {
+                        this->releaseTile(this->tileMap_[r][c]);
+                        this->tileMap_[r][c] = tile;
+                    }
+                }
+            }
+            this->gridMoveWidget(tile, row, column, rowSpan, columnSpan);
+            tile->updateSize(row, column, rowSpan, columnSpan);
+        }
+    }
+    this->widgetTiles_.insert(widget, tile);
+    this->widgets_.append(widget);
+
+    widget->setMouseTracking(!this->eventDispatch);
     tile->addWidget(widget);
+    this->grid_.place(this->gridKey(widget), QRect(column, row, columnSpan, rowSpan));
+    if ((this->scrollArea_ != nullptr) && !this->materializedTiles_.contains(tile)) {
+        emit this->widgetDematerialized(widget);
+    }
+    this->invalidateTilesColor(row, column, rowSpan, columnSpan);
 }
 
 void QTileLayout::removeWidget(QWidget* const widget)
 {
-    assert(this->widgets_.contains(widget));
+    QTILELAYOUT_STATS_SCOPE(RemoveWidget);
+    QTILELAYOUT_TRACE(RemoveWidget, this->traceWidgetId(widget));
+    assert(this->widgetTiles_.contains(widget));
+
+    if ((widget == this->widgetToDrop_) && this->widgetFactories_.contains(widget)) {
+        this->buildWidget(widget);
+        this->removeWidget(this->widgetToDrop_);
+        return;
+    }
 
-    qsizetype index = this->widgets_.indexOf(widget);
-    QTileWidget *tile = this->tiles_[index];
+    QTileWidget *tile = this->widgetTiles_.take(widget);
+    this->widgets_.removeOne(widget);
+    if (widget != this->widgetToDrop_) {
+        this->dragPixmaps_.remove(widget);
+    }
+    if (this->selection_.removeOne(widget)) {
+        this->updateSelectionOutline();
+        emit this->selectionChanged();
+    }
+    if (this->widgetFactories_.remove(widget)) {
+        this->pendingFactories_.removeOne(widget);
+        widget->removeEventFilter(this);
+    }
 
     int row = tile->getRow();
     int column = tile->getColumn();
@@ -64,75 +372,292 @@ void QTileLayout::removeWidget(QWidget* const widget)
     }
 
     widget->setMouseTracking(false);
+    this->grid_.remove(this->gridKey(widget));
     this->hardSplitTiles(row, column, tileToSplit);
-    this->widgets_.removeAt(index);
-    this->tiles_.removeAt(index);
     this->changeTilesColor(this->colorIdle);
 }
 
+QByteArray QTileLayout::saveState(const QHash<QWidget*, QString> &widgetIds)
+{
+    QList<QPair<QString, QRect>> entries;
+    for (QWidget *widget : this->widgets_) {
+        if (widgetIds.contains(widget)) {
+            QTileWidget *tile = this->widgetTiles_[widget];
+            entries.append({
+                widgetIds[widget],
+                QRect(tile->getColumn(), tile->getRow(), tile->getColumnSpan(), tile->getRowSpan())
+            });
+        }
+    }
+
+    QByteArray state;
+    QDataStream stream(&state, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << this->STATE_MAGIC << this->STATE_VERSION;
+    stream << qint32(this->rows) << qint32(this->columns);
+    stream << qint32(this->verticalSpan) << qint32(this->horizontalSpan);
+    stream << qint32(this->verticalSpacing()) << qint32(this->horizontalSpacing());
+    for (int size : this->rowAxis().fixedSizes()) {
+        stream << qint32(size);
+    }
+    for (int size : this->columnAxis().fixedSizes()) {
+        stream << qint32(size);
+    }
+    stream << quint32(entries.size());
+    for (const QPair<QString, QRect> &entry : entries) {
+        stream << entry.first;
+        stream << qint32(entry.second.y()) << qint32(entry.second.x());
+        stream << qint32(entry.second.height()) << qint32(entry.second.width());
+    }
+    return state;
+}
+
+bool QTileLayout::restoreState(const QByteArray &state, const QHash<QString, QWidget*> &widgets)
+{
+    QTILELAYOUT_STATS_SCOPE(RestoreState);
+
+    QDataStream stream(state);
+    stream.setVersion(QDataStream::Qt_6_0);
+    quint32 magic;
+    quint16 version;
+    qint32 rows, columns, verticalSpan, horizontalSpan, verticalSpacing, horizontalSpacing;
+    quint32 count;
+    stream >> magic >> version;
+    if ((stream.status() != QDataStream::Ok) || (magic != this->STATE_MAGIC) || (version < 1) || (version > this->STATE_VERSION)) {
+        return false;
+    }
+    stream >> rows >> columns >> verticalSpan >> horizontalSpan >> verticalSpacing >> horizontalSpacing;
+    if (
+        (stream.status() != QDataStream::Ok) ||
+        (rows <= 0) || (columns <= 0) || (verticalSpan <= 0) || (horizontalSpan <= 0) ||
+        (qint64(rows) * qint64(columns) > this->STATE_MAX_CELLS)
+        ) {
+        return false;
+    }
+    if ((version >= 2) && ((qint64(rows) + qint64(columns)) * 4 > state.size() - stream.device()->pos())) {
+        return false;
+    }
+
+    QList<qint32> rowHeights(rows, 0);
+    QList<qint32> columnWidths(columns, 0);
+    if (version >= 2) {
+        for (qint32 &height : rowHeights) {
+            stream >> height;
+            if (height < 0) {
+                return false;
+            }
+        }
+        for (qint32 &width : columnWidths) {
+            stream >> width;
+            if (width < 0) {
+                return false;
+            }
+        }
+    }
+    stream >> count;
+    if ((stream.status() != QDataStream::Ok) || (qint64(count) * this->STATE_ENTRY_MIN_SIZE > state.size() - stream.device()->pos())) {
+        return false;
+    }
+
+    QTileGrid grid(rows, columns);
+    QList<QPair<QWidget*, QRect>> placements;
+    for (quint32 index = 0; index < count; index++) {
+        QString id;
+        qint32 row, column, rowSpan, columnSpan;
+        stream >> id >> row >> column >> rowSpan >> columnSpan;
+        QRect cells(column, row, columnSpan, rowSpan);
+        if (
+            (stream.status() != QDataStream::Ok) ||
+            !grid.isAreaEmpty(row, column, rowSpan, columnSpan)
+            ) {
+            return false;
+        }
+        QWidget *widget = widgets.value(id);
+        if (widget != nullptr) {
+            if (!grid.place(this->gridKey(widget), cells)) {
+                return false;
+            }
+            placements.append({widget, cells});
+        }
+    }
+
+    this->beginUpdate();
+
+    QSet<QWidget*> restored;
+    for (const QPair<QWidget*, QRect> &placement : placements) {
+        restored.insert(placement.first);
+    }
+    for (auto itr = this->widgetTiles_.constBegin(); itr != this->widgetTiles_.constEnd(); ++itr) {
+        QWidget *widget = itr.key();
+        itr.value()->removeWidget();
+        widget->setMouseTracking(false);
+        if (!restored.contains(widget) && this->widgetFactories_.remove(widget)) {
+            this->pendingFactories_.removeOne(widget);
+            widget->removeEventFilter(this);
+            widget->setParent(nullptr);
+            widget->deleteLater();
+            continue;
+        }
+        widget->setParent(this->parentWidget());
+        widget->setVisible(false);
+    }
+    this->widgetTiles_ = {};
+    this->widgets_ = {};
+    this->dragPixmaps_ = {};
+    this->clearSelection();
+
+    QSet<QTileWidget*> tiles;
+    for (const QList<QTileWidget*> &tileMapRow : this->tileMap_) {
+        for (QTileWidget *tile : tileMapRow) {
+            if (tile != nullptr) {
+                tiles.insert(tile);
+            }
+        }
+    }
+    for (QTileWidget *tile : tiles) {
+        this->releaseTile(tile);
+    }
+
+    this->setRowStretch(this->rows, 0);
+    this->setColumnStretch(this->columns, 0);
+    for (int row = rows; row < this->rows; row++) {
+        this->setRowMinimumHeight(row, 0);
+    }
+    for (int column = columns; column < this->columns; column++) {
+        this->setColumnMinimumWidth(column, 0);
+    }
+    this->rows = rows;
+    this->columns = columns;
+    this->setRowStretch(this->rows, 1);
+    this->setColumnStretch(this->columns, 1);
+
+    this->verticalSpan = verticalSpan;
+    this->horizontalSpan = horizontalSpan;
+    this->minVerticalSpan = qMin(this->minVerticalSpan, verticalSpan);
+    this->minHorizontalSpan = qMin(this->minHorizontalSpan, horizontalSpan);
+    Super::setVerticalSpacing(verticalSpacing);
+    Super::setHorizontalSpacing(horizontalSpacing);
+
+    this->rowAxis_ = QTileAxis();
+    this->columnAxis_ = QTileAxis();
+    this->syncAxes();
+    for (int row = 0; row < rows; row++) {
+        this->rowAxis_.setSize(row, rowHeights[row]);
+    }
+    for (int column = 0; column < columns; column++) {
+        this->columnAxis_.setSize(column, columnWidths[column]);
+    }
+
+    this->tileMap_ = QList<QList<QTileWidget*>>(rows, QList<QTileWidget*>(columns, nullptr));
+    this->grid_ = QTileGrid(rows, columns);
+    this->updateBackground();
+    for (const QPair<QWidget*, QRect> &placement : placements) {
+        const QRect &cells = placement.second;
+        this->placeWidget(placement.first, cells.y(), cells.x(), cells.height(), cells.width());
+        placement.first->setVisible(true);
+    }
+    if (!this->emptyCellMode) {
+        for (int row = 0; row < rows; row++) {
+            for (int column = 0; column < columns; column++) {
+                if (this->tileMap_[row][column] == nullptr) {
+                    this->createTile(row, column, true);
+                }
+            }
+        }
+    }
+
+    this->updateAllTiles();
+    this->endUpdate();
+    return true;
+}
+
 void QTileLayout::addRows(const int rows)
 {
+    QTILELAYOUT_STATS_SCOPE(AddRows);
+    QTILELAYOUT_TRACE(AddRows, rows);
     assert(rows > 0);
     this->setRowStretch(this->rows, 0);
 
     for (int r = this->rows; r < this->rows + rows; r++) {
         this->tileMap_.append(QList<QTileWidget*>());
         for (int c = 0; c < this->columns; c++) {
-            QTileWidget* tile = this->createTile(r, c);
+            QTileWidget* tile = this->emptyCellMode ? nullptr : this->createTile(r, c);
             this->tileMap_[r].append(tile);
         }
+        this->setRowMinimumHeight(r, this->verticalSpan);
     }
     this->rows += rows;
+    this->syncAxes();
     this->setRowStretch(this->rows, 1);
+    this->grid_.resize(this->rows, this->columns);
+    this->updateBackground();
 }
 
 void QTileLayout::addColumns(const int columns)
 {
+    QTILELAYOUT_STATS_SCOPE(AddColumns);
+    QTILELAYOUT_TRACE(AddColumns, columns);
     assert(columns > 0);
     this->setColumnStretch(this->columns, 0);
 
     for (int r = 0; r < this->rows; r++) {
         for (int c = this->columns; c < this->columns + columns; c++) {
-            QTileWidget* tile = this->createTile(r, c);
+            QTileWidget* tile = this->emptyCellMode ? nullptr : this->createTile(r, c);
             this->tileMap_[r].append(tile);
         }
     }
+    for (int c = this->columns; c < this->columns + columns; c++) {
+        this->setColumnMinimumWidth(c, this->horizontalSpan);
+    }
     this->columns += columns;
+    this->syncAxes();
     this->setColumnStretch(this->columns, 1);
+    this->grid_.resize(this->rows, this->columns);
+    this->updateBackground();
 }
 
 void QTileLayout::removeRows(const int rows) {
+    QTILELAYOUT_STATS_SCOPE(RemoveRows);
+    QTILELAYOUT_TRACE(RemoveRows, rows);
     assert(this->isAreaEmpty(this->rows - rows, 0, rows, this->columns));
 
     for (int r = this->rows - rows; r < this->rows; r++) {
         for (int c = 0; c < this->columns; c++) {
             QTileWidget* tile = this->tileMap_[r][c];
-            Super::removeWidget(tile);
-            tile->deleteLater();
+            if (tile != nullptr) {
+                this->releaseTile(tile);
+            }
         }
         this->setRowMinimumHeight(r, 0);
         this->setRowStretch(r, 0);
     }
     this->rows -= rows;
+    this->syncAxes();
 
     for (int r = 0; r < rows; r++) {
         this->tileMap_.removeLast();
     }
+    this->grid_.resize(this->rows, this->columns);
+    this->updateBackground();
 }
 
 void QTileLayout::removeColumns(const int columns) {
+    QTILELAYOUT_STATS_SCOPE(RemoveColumns);
+    QTILELAYOUT_TRACE(RemoveColumns, columns);
     assert(this->isAreaEmpty(0, this->columns - columns, this->rows, columns));
 
     for (int c = this->columns - columns; c < this->columns; c++) {
         for (int r = 0; r < this->rows; r++) {
             QTileWidget *tile = this->tileMap_[r][c];
-            Super::removeWidget(tile);
-            tile->deleteLater();
+            if (tile != nullptr) {
+                this->releaseTile(tile);
+            }
         }
         this->setColumnMinimumWidth(c, 0);
         this->setColumnStretch(c, 0);
     }
     this->columns -= columns;
+    this->syncAxes();
 
     for (int r = 0; r < this->rows; r++) {
         QList<QTileWidget* > *tileMapRow = &this->tileMap_[r];
@@ -140,6 +665,41 @@ void QTileLayout::removeColumns(const int columns) {
             tileMapRow->removeLast();
         }
     }
+    this->grid_.resize(this->rows, this->columns);
+    this->updateBackground();
+}
+
+void QTileLayout::beginUpdate(void)
+{
+    this->updateDepth_++;
+}
+
+void QTileLayout::endUpdate(void)
+{
+    assert(this->updateDepth_ > 0);
+    this->updateDepth_--;
+    if (this->updateDepth_ > 0) {
+        return;
+    }
+
+    for (int index = this->count() - 1; index >= 0; index--) {
+        QWidget *widget = this->itemAt(index)->widget();
+        if (this->pendingRemovals_.contains(widget) || this->pendingPlacements_.contains(widget)) {
+            delete this->takeAt(index);
+        }
+    }
+    this->pendingRemovals_.clear();
+
+    for (auto itr = this->pendingPlacements_.constBegin(); itr != this->pendingPlacements_.constEnd(); ++itr) {
+        const QRect &cells = itr.value();
+        Super::addWidget(itr.key(), cells.y(), cells.x(), cells.height(), cells.width());
+    }
+    this->pendingPlacements_.clear();
+
+    if (this->pendingUpdateAllTiles_) {
+        this->pendingUpdateAllTiles_ = false;
+        this->updateAllTiles();
+    }
 }
 
 void QTileLayout::acceptDragAndDrop(const bool accept)
@@ -152,9 +712,206 @@ void QTileLayout::acceptResizing(const bool accept)
     this->resizable = accept;
 }
 
+void QTileLayout::acceptSelection(const bool accept)
+{
+    this->selectable = accept;
+    if (!accept) {
+        this->clearSelection();
+    }
+}
+
+void QTileLayout::activateEmptyCellMode(const bool activate)
+{
+    if (this->emptyCellMode == activate) {
+        return;
+    }
+    this->emptyCellMode = activate;
+
+    for (int r = 0; r < this->rows; r++) {
+        for (int c = 0; c < this->columns; c++) {
+            QTileWidget *tile = this->tileMap_[r][c];
+            if (activate && (tile != nullptr) && !tile->isFilled()) {
+                this->releaseTile(tile);
+                this->tileMap_[r][c] = nullptr;
+            } else if (!activate && (tile == nullptr)) {
+                this->createTile(r, c, true);
+            }
+        }
+    }
+    this->resetTilesColor();
+    this->changeTilesColor(this->colorIdle);
+}
+
+void QTileLayout::activateVirtualization(QAbstractScrollArea* const scrollArea)
+{
+    assert(scrollArea != nullptr);
+    this->deactivateVirtualization();
+    this->virtualizationEmptyCellMode_ = this->emptyCellMode;
+    this->activateEmptyCellMode(true);
+
+    this->scrollArea_ = scrollArea;
+    this->materializedTiles_ = {};
+    for (QTileWidget *tile : this->widgetTiles_) {
+        this->materializedTiles_.insert(tile);
+    }
+    this->virtualArea_ = QRect(0, 0, this->columns, this->rows);
+
+    connect(scrollArea->horizontalScrollBar(), &QScrollBar::valueChanged, this, &QTileLayout::updateVirtualization);
+    connect(scrollArea->verticalScrollBar(), &QScrollBar::valueChanged, this, &QTileLayout::updateVirtualization);
+    scrollArea->viewport()->installEventFilter(this);
+    this->updateVirtualization();
+}
+
+void QTileLayout::deactivateVirtualization(void)
+{
+    if (this->scrollArea_ == nullptr) {
+        return;
+    }
+
+    disconnect(this->scrollArea_->horizontalScrollBar(), nullptr, this, nullptr);
+    disconnect(this->scrollArea_->verticalScrollBar(), nullptr, this, nullptr);
+    this->scrollArea_->viewport()->removeEventFilter(this);
+    this->scrollArea_ = nullptr;
+
+    this->beginUpdate();
+    for (QTileWidget *tile : this->widgetTiles_) {
+        if (!this->materializedTiles_.contains(tile)) {
+            this->materializeTile(tile);
+        }
+    }
+    this->endUpdate();
+    this->materializedTiles_ = {};
+    this->virtualArea_ = QRect();
+    this->activateEmptyCellMode(this->virtualizationEmptyCellMode_);
+}
+
+void QTileLayout::setVirtualizationMargin(const int margin)
+{
+    this->virtualizationMargin = margin;
+    this->updateVirtualization();
+}
+
+void QTileLayout::activateEventDispatch(const bool activate)
+{
+    assert(!activate || (this->parentWidget() != nullptr));
+    if (this->dispatchWidget_ != nullptr) {
+        QCoreApplication::instance()->removeEventFilter(this);
+        this->dispatchWidget_->unsetCursor();
+        this->dispatchWidget_ = nullptr;
+    }
+    this->eventDispatch = activate;
+
+    for (const QList<QTileWidget*> &tileMapRow : this->tileMap_) {
+        for (QTileWidget *tile : tileMapRow) {
+            if (tile != nullptr) {
+                tile->setMouseTracking(!activate);
+                tile->unsetCursor();
+            }
+        }
+    }
+    for (QWidget *widget : this->widgets_) {
+        widget->setMouseTracking(!activate);
+    }
+
+    if (activate) {
+        this->dispatchWidget_ = this->parentWidget();
+        QCoreApplication::instance()->installEventFilter(this);
+    }
+}
+
+void QTileLayout::setTilePoolCapacity(const int capacity)
+{
+    assert(capacity >= 0);
+    this->tilePoolCapacity = capacity;
+    while (this->tilePool_.size() > capacity) {
+        QTILELAYOUT_STATS_COUNT(TilesDeleted, 1);
+        this->tilePool_.takeLast()->deleteLater();
+    }
+}
+
+int QTileLayout::tilePoolSize(void)
+{
+    return this->tilePool_.size();
+}
+
+qreal QTileLayout::tilePoolHitRate(void)
+{
+    if (this->tilePoolRequests_ == 0) {
+        return 0;
+    }
+    return qreal(this->tilePoolHits_) / this->tilePoolRequests_;
+}
+
+void QTileLayout::clearTilePool(void)
+{
+    QTILELAYOUT_STATS_COUNT(TilesDeleted, this->tilePool_.size());
+    for (QTileWidget *tile : this->tilePool_) {
+        tile->deleteLater();
+    }
+    this->tilePool_ = {};
+    this->tilePoolRequests_ = 0;
+    this->tilePoolHits_ = 0;
+}
+
+void QTileLayout::activateStats(const bool activate)
+{
+    this->statsEnabled_ = activate;
+}
+
+const QTileLayoutStats& QTileLayout::stats(void)
+{
+    return this->stats_;
+}
+
+void QTileLayout::resetStats(void)
+{
+    this->stats_.reset();
+}
+
+void QTileLayout::startTrace(QIODevice* const device)
+{
+    assert((device != nullptr) && device->isWritable());
+    this->stopTrace();
+
+    QTileTrace::Header header;
+    header.rows = this->rows;
+    header.columns = this->columns;
+    header.verticalSpan = this->verticalSpan;
+    header.horizontalSpan = this->horizontalSpan;
+    header.verticalSpacing = this->verticalSpacing();
+    header.horizontalSpacing = this->horizontalSpacing();
+    header.emptyCellMode = this->emptyCellMode;
+    header.rowHeights = {};
+    for (int height : this->rowAxis_.fixedSizes()) {
+        header.rowHeights.append(height);
+    }
+    header.columnWidths = {};
+    for (int width : this->columnAxis_.fixedSizes()) {
+        header.columnWidths.append(width);
+    }
+    header.widgets = {};
+    for (auto itr = this->widgetTiles_.constBegin(); itr != this->widgetTiles_.constEnd(); ++itr) {
+        QTileWidget *tile = itr.value();
+        header.widgets.append({
+            this->traceWidgetId(itr.key()),
+            QRect(tile->getColumn(), tile->getRow(), tile->getColumnSpan(), tile->getRowSpan())
+        });
+    }
+
+    this->trace_.setDevice(device);
+    this->trace_.writeHeader(header);
+}
+
+void QTileLayout::stopTrace(void)
+{
+    this->trace_.setDevice(nullptr);
+    this->traceWidgetIds_ = {};
+}
+
 void QTileLayout::setCursorIdle(const Qt::CursorShape &cursor)
 {
     this->cursorIdle = cursor;
+    this->background_->setCursor(cursor);
 }
 
 void QTileLayout::setCursorGrab(const Qt::CursorShape &cursor)
@@ -175,6 +932,7 @@ void QTileLayout::setCursorResizeVertical(const Qt::CursorShape &cursor)
 void QTileLayout::setColorIdle(const QColor &color)
 {
     this->colorIdle = color;
+    this->invalidateTilesColor(0, 0, this->rows, this->columns);
     this->changeTilesColor(color);
 }
 
@@ -191,6 +949,37 @@ void QTileLayout::setColorDragAndDrop(const QColor &color)
 void QTileLayout::setColorEmptyCheck(const QColor &color)
 {
     this->colorEmptyCheck = color;
+    this->dragPixmaps_ = {};
+}
+
+void QTileLayout::setColorSelected(const QColor &color)
+{
+    this->colorSelected = color;
+    this->updateSelectionOutline();
+}
+
+void QTileLayout::setDragPixmapMaximumSize(const QSize &size)
+{
+    this->dragPixmapMaximumSize = size;
+    this->dragPixmaps_ = {};
+}
+
+void QTileLayout::activateDragPixmapCache(const bool activate)
+{
+    this->dragPixmapCache = activate;
+    this->dragPixmaps_ = {};
+}
+
+void QTileLayout::setDragOutlineThreshold(const int area)
+{
+    assert(area >= 0);
+    this->dragOutlineThreshold = area;
+    this->dragPixmaps_ = {};
+}
+
+void QTileLayout::invalidateDragPixmap(QWidget* const widget)
+{
+    this->dragPixmaps_.remove(widget);
 }
 
 int QTileLayout::rowCount(void)
@@ -205,7 +994,11 @@ int QTileLayout::columnCount(void)
 
 QRect QTileLayout::tileRect(const int row, const int column)
 {
-    return this->tileMap_[row][column]->rect();
+    QTileWidget *tile = this->tileMap_[row][column];
+    if (tile == nullptr) {
+        return QRect(0, 0, this->columnWidth(column), this->rowHeight(row));
+    }
+    return tile->rect();
 }
 
 int QTileLayout::rowsMinimumHeight(void)
@@ -218,47 +1011,111 @@ int QTileLayout::columnsMinimumWidth(void)
     return this->minHorizontalSpan;
 }
 
-void QTileLayout::setRowsMinimumHeight(const int height)
+void QTileLayout::setRowsMinimumHeight(const int height)
+{
+    this->minVerticalSpan = height;
+    if (this->minVerticalSpan > this->verticalSpan) {
+        this->verticalSpan = this->minVerticalSpan;
+        this->syncAxes();
+        this->updateAllTiles();
+    }
+}
+
+void QTileLayout::setColumnsMinimumWidth(const int width)
+{
+    this->minHorizontalSpan = width;
+    if (this->minHorizontalSpan > this->horizontalSpan) {
+        this->horizontalSpan = this->minHorizontalSpan;
+        this->syncAxes();
+        this->updateAllTiles();
+    }
+}
+
+void QTileLayout::setRowsHeight(const int height)
+{
+    assert(this->minVerticalSpan <= height);
+    this->verticalSpan = height;
+    this->syncAxes();
+    this->updateAllTiles();
+}
+
+void QTileLayout::setColumnsWidth(const int width)
+{
+    assert(this->minHorizontalSpan <= width);
+    this->horizontalSpan = width;
+    this->syncAxes();
+    this->updateAllTiles();
+}
+
+void QTileLayout::setRowHeight(const int row, const int height)
+{
+    assert((row >= 0) && (row < this->rows) && (height >= 0));
+    QTILELAYOUT_TRACE(SetRowHeight, row, height);
+    if (!this->rowAxis_.setSize(row, height)) {
+        return;
+    }
+
+    for (int column = 0; column < this->columns; column++) {
+        QTileWidget *tile = this->tileMap_[row][column];
+        if ((tile != nullptr) && (tile->getColumn() == column)) {
+            tile->updateSize();
+        }
+    }
+    this->setRowMinimumHeight(row, this->rowHeight(row));
+    this->background_->update();
+    this->updateVirtualization();
+}
+
+void QTileLayout::setColumnWidth(const int column, const int width)
+{
+    assert((column >= 0) && (column < this->columns) && (width >= 0));
+    QTILELAYOUT_TRACE(SetColumnWidth, column, width);
+    if (!this->columnAxis_.setSize(column, width)) {
+        return;
+    }
+
+    for (int row = 0; row < this->rows; row++) {
+        QTileWidget *tile = this->tileMap_[row][column];
+        if ((tile != nullptr) && (tile->getRow() == row)) {
+            tile->updateSize();
+        }
+    }
+    this->setColumnMinimumWidth(column, this->columnWidth(column));
+    this->background_->update();
+    this->updateVirtualization();
+}
+
+int QTileLayout::rowHeight(const int row)
 {
-    this->minVerticalSpan = height;
-    if (this->minVerticalSpan > this->verticalSpan) {
-        this->verticalSpan = this->minVerticalSpan;
-        this->updateAllTiles();
-    }
+    return this->rowAxis().size(row);
 }
 
-void QTileLayout::setColumnsMinimumWidth(const int width)
+int QTileLayout::columnWidth(const int column)
 {
-    this->minHorizontalSpan = width;
-    if (this->minHorizontalSpan > this->horizontalSpan) {
-        this->horizontalSpan = this->minHorizontalSpan;
-        this->updateAllTiles();
-    }
+    return this->columnAxis().size(column);
 }
 
-void QTileLayout::setRowsHeight(const int height)
+const QTileAxis& QTileLayout::rowAxis(void)
 {
-    assert(this->minVerticalSpan <= height);
-    this->verticalSpan = height;
-    this->updateAllTiles();
+    return this->rowAxis_;
 }
 
-void QTileLayout::setColumnsWidth(const int width)
+const QTileAxis& QTileLayout::columnAxis(void)
 {
-    assert(this->minHorizontalSpan <= width);
-    this->horizontalSpan = width;
-    this->updateAllTiles();
+    return this->columnAxis_;
 }
 
 void QTileLayout::setVerticalSpacing(const int spacing)
 {
     Super::setVerticalSpacing(spacing);
+    this->syncAxes();
     this->updateAllTiles();
 }
 
 void QTileLayout::setHorizontalSpacing(const int spacing)
 {
     Super::setHorizontalSpacing(spacing);
+    this->syncAxes();
     this->updateAllTiles();
 }
 
@@ -272,6 +1129,24 @@ void QTileLayout::activateFocus(const bool focus)
     this->focus = focus;
 }
 
+QRect QTileLayout::tileOf(QWidget* const widget)
+{
+    QTileWidget *tile = this->widgetTiles_.value(widget, nullptr);
+    if (tile == nullptr) {
+        return QRect();
+    }
+    return QRect(tile->getColumn(), tile->getRow(), tile->getColumnSpan(), tile->getRowSpan());
+}
+
+QWidget* QTileLayout::widgetAt(const int row, const int column)
+{
+    QTileWidget *tile = this->tileMap_[row][column];
+    if (tile == nullptr) {
+        return nullptr;
+    }
+    return tile->getWidget();
+}
+
 QList<QWidget*> QTileLayout::widgetList(void)
 {
     return this->widgets_;
@@ -301,26 +1176,18 @@ void QTileLayout::setWidgetToDrop(QWidget* const widget)
 
 void QTileLayout::changeTilesColor(const QColor &color)
 {
-    this->changeTilesColor(color, 0, 0, this->rows, this->columns);
+    this->applyTilesColor(color, QRect(), QColor());
 }
 
 void QTileLayout::changeTilesColor(const QColor &color, const int fromRow, const int fromColumn, const int toRow, const int toColumn)
 {
-    QPalette palette;
-    palette.setColor(QPalette::ColorRole::Window, color);
-    QPalette paletteIdle;
-    paletteIdle.setColor(QPalette::ColorRole::Window, this->colorIdle);
-
-    for (int row = fromRow; row < fromRow + toRow; row++) {
-        for (int column = fromColumn; column < fromColumn + toColumn; column++) {
-            QTileWidget* tile = this->tileMap_[row][column];
-            if (tile->isFilled()) {
-                tile->changeColor(paletteIdle);
-            } else {
-                tile->changeColor(palette);
-            }
+    QRect area = QRect(fromColumn, fromRow, toColumn, toRow).intersected(QRect(0, 0, this->columns, this->rows));
+    for (int row = area.top(); row <= area.bottom(); row++) {
+        for (int column = area.left(); column <= area.right(); column++) {
+            this->changeCellColor(row, column, color);
         }
     }
+    this->highlightArea_ |= area;
 }
 
 QWidget* QTileLayout::getWidgetToDrop(void)
@@ -330,99 +1197,197 @@ QWidget* QTileLayout::getWidgetToDrop(void)
     return widget;
 }
 
+int QTileLayout::resizeExtent(QPair<int, int>* const direction, const int row, const int column)
+{
+    QTileWidget *tile = this->tileMap_[row][column];
+    QRect area(tile->getColumn(), tile->getRow(), tile->getColumnSpan(), tile->getRowSpan());
+    return this->grid_.freeExtent(area, *direction);
+}
+
 void QTileLayout::highlightTiles(QPair<int, int>* const direction, const int row, const int column, const int tileCount)
 {
-    int tmpRow = row;
-    int tmpColumn = column;
-    QSet<QPair<int, int> > tilesToMerge;
-    bool increase;
-    int rowSpan;
-    int columnSpan;
-    this->getTilesToBeResized(
-        this->tileMap_[row][column], direction,
-        tmpRow, tmpColumn,
-        tileCount, tilesToMerge,
-        increase, rowSpan, columnSpan
-        );
+    this->highlightTiles(direction, row, column, tileCount, this->resizeExtent(direction, row, column));
+}
 
-    if (!tilesToMerge.empty()) {
-        this->changeTilesColor(
-            this->colorEmptyCheck,
-            tmpRow, tmpColumn,
-            rowSpan, columnSpan
-            );
-    }
+void QTileLayout::highlightTiles(QPair<int, int>* const direction, const int row, const int column, const int tileCount, const int extent)
+{
+    QTileWidget *tile = this->tileMap_[row][column];
+    QRect area(tile->getColumn(), tile->getRow(), tile->getColumnSpan(), tile->getRowSpan());
+    QRect resized = QTileGrid::resizedArea(area, *direction, tileCount, extent);
+    this->applyTilesColor(this->colorResize, (resized != area)? resized : QRect(), this->colorEmptyCheck);
 }
 
 void QTileLayout::resizeTile(QPair<int, int>* const direction, const int row, const int column, const int tileCount)
 {
+    this->resizeTile(direction, row, column, tileCount, this->resizeExtent(direction, row, column));
+}
+
+void QTileLayout::resizeTile(QPair<int, int>* const direction, const int row, const int column, const int tileCount, const int extent)
+{
+    QTILELAYOUT_STATS_SCOPE(ResizeTile);
+    QTILELAYOUT_TRACE(ResizeTile, direction->first, direction->second, row, column, tileCount);
     QTileWidget *tile = this->tileMap_[row][column];
-    int tmpRow = row;
-    int tmpColumn = column;
-    QSet<QPair<int, int> > tilesToMerge;
-    bool increase;
-    int rowSpan;
-    int columnSpan;
-    this->getTilesToBeResized(
-        tile, direction,
-        tmpRow, tmpColumn,
-        tileCount, tilesToMerge,
-        increase, rowSpan, columnSpan
-        );
+    if ((tile == nullptr) || (tile->getWidget() == nullptr)) {
+        return;
+    }
+    QRect area(tile->getColumn(), tile->getRow(), tile->getColumnSpan(), tile->getRowSpan());
+    QRect resized = QTileGrid::resizedArea(area, *direction, tileCount, extent);
+    QTileGrid::Key key = this->gridKey(tile->getWidget());
+    if (!this->grid_.isAreaFree(key, resized)) {
+        resized = this->grid_.resizedArea(area, *direction, tileCount);
+    }
+    if (resized == area) {
+        return;
+    }
 
-    if (!tilesToMerge.empty()) {
-        if (increase) {
-            this->mergeTiles(tile, tmpRow, tmpColumn, rowSpan, columnSpan, tilesToMerge);
-        } else {
-            this->splitTiles(tile, tmpRow, tmpColumn, rowSpan, columnSpan, tilesToMerge);
-        }
-        int index = this->tiles_.indexOf(tile);
-        QWidget *widget = this->widgets_[index];
-        emit this->tileResized(widget, row, column, rowSpan, columnSpan);
+    if (resized.width() * resized.height() > area.width() * area.height()) {
+        this->mergeTiles(tile, area, resized);
+    } else {
+        this->splitTiles(tile, area, resized);
     }
+    this->grid_.move(key, resized);
+    this->updateSelectionOutline();
+    emit this->tileResized(tile->getWidget(), row, column, resized.height(), resized.width());
 }
 
 bool QTileLayout::isAreaEmpty(const int row, const int column, const int rowSpan, const int columnSpan)
 {
-    if ((row + rowSpan > this->rows) || (column + columnSpan > this->columns) || (row < 0) || (column < 0)) {
-        return false;
-    } else {
-        bool isEmpty = true;
-        for (int r = row; r < row + rowSpan; r++) {
-            for (int c = column; c < column + columnSpan; c++) {
-                isEmpty &= !(this->tileMap_[r][c]->isFilled());
-            }
-        }
-        return isEmpty;
-    }
+    return this->grid_.isAreaEmpty(row, column, rowSpan, columnSpan);
 }
 
 bool QTileLayout::isAreaEmpty(const int row, const int column, const int rowSpan, const int columnSpan, const QColor &color)
 {
-    if (color != nullptr) {
-        this->changeTilesColor(color);
-    }
     bool isEmpty = this->isAreaEmpty(row, column, rowSpan, columnSpan);
+    QRect area;
     if (isEmpty == true) {
-        this->changeTilesColor(this->colorEmptyCheck, row, column, rowSpan, columnSpan);
+        area = QRect(column, row, columnSpan, rowSpan);
     }
+    this->applyTilesColor(color.isValid()? color : this->baseColor_, area, this->colorEmptyCheck);
     return isEmpty;
 }
 
-void QTileLayout::updateGlobalSize(QResizeEvent newSize)
+bool QTileLayout::isDropPossible(const QMimeData* const mimeData, const int row, const int column)
+{
+    const QTileDropData *dropData = QTileDropData::fromMimeData(mimeData);
+
+    if (dropData == nullptr) return false;
+    if (!this->linkedLayouts.contains(dropData->id)) return false;
+
+    QMapIterator<QUuid, QTileLayout*> itr(this->linkedLayouts.value(dropData->id)->linkedLayouts);
+    while (itr.hasNext()) {
+        auto item = itr.next();
+        if ((item.value() != this) && item.value()->dragAndDrop) {
+            item.value()->changeTilesColor(this->colorDragAndDrop);
+        }
+    }
+
+    return this->isAreaEmpty(
+        row - dropData->rowOffset,
+        column - dropData->columnOffset,
+        dropData->rowSpan,
+        dropData->columnSpan,
+        this->colorDragAndDrop
+        );
+}
+
+void QTileLayout::dropWidget(const QMimeData* const mimeData, const int row, const int column)
+{
+    QTILELAYOUT_STATS_SCOPE(DropWidget);
+    const QTileDropData *dropData = QTileDropData::fromMimeData(mimeData);
+    assert(dropData != nullptr);
+
+    QUuid id = dropData->id;
+    int fromRow = dropData->row;
+    int fromColumn = dropData->column;
+    int rowSpan = dropData->rowSpan;
+    int columnSpan = dropData->columnSpan;
+    int rowOffset = dropData->rowOffset;
+    int columnOffset = dropData->columnOffset;
+
+    QWidget* widget = this->linkedLayouts[id]->getWidgetToDrop();
+    if (this->linkedLayouts[id] != this) {
+        QPixmap pixmap = this->linkedLayouts[id]->dragPixmaps_.take(widget);
+        if (!pixmap.isNull()) {
+            this->dragPixmaps_.insert(widget, pixmap);
+        }
+    }
+    QTILELAYOUT_TRACE(
+        DropWidget,
+        this->traceWidgetId(widget),
+        row - rowOffset, column - columnOffset,
+        rowSpan, columnSpan
+        );
+
+    this->addWidget(
+        widget,
+        row - rowOffset, column - columnOffset,
+        rowSpan, columnSpan
+        );
+    emit this->tileMoved(
+        widget, id, this->id,
+        fromRow, fromColumn,
+        row - rowOffset, column - columnOffset
+        );
+}
+
+void QTileLayout::updateGlobalSize(const QResizeEvent &newSize)
+{
+    this->updateGlobalSize(newSize.size());
+}
+
+void QTileLayout::updateGlobalSize(const QSize &size)
+{
+    QTILELAYOUT_TRACE(UpdateGlobalSize, size.width(), size.height());
+    this->pendingGlobalSize_ = size;
+    if (!this->resizeCoalescing) {
+        this->applyGlobalSize();
+    } else if (!this->resizeTimer_->isActive()) {
+        this->resizeTimer_->start(this->resizeCoalescingInterval);
+    }
+}
+
+void QTileLayout::activateResizeCoalescing(const bool activate)
+{
+    this->resizeCoalescing = activate;
+    if (!activate && this->resizeTimer_->isActive()) {
+        this->resizeTimer_->stop();
+        this->applyGlobalSize();
+    }
+}
+
+void QTileLayout::applyGlobalSize(void)
 {
+    QTILELAYOUT_STATS_SCOPE(UpdateGlobalSize);
+    const QSize &size = this->pendingGlobalSize_;
+    const QTileAxis &rowAxis = this->rowAxis();
     int verticalMargins = this->contentsMargins().top() + this->contentsMargins().bottom();
-    int verticalSpan = (newSize.size().height() - (this->rows - 1) * this->verticalSpacing() - verticalMargins) / this->rows;
+    int verticalSpan = this->verticalSpan;
+    if (rowAxis.fixedCount() < this->rows) {
+        int height = size.height() - (this->rows - 1) * this->verticalSpacing() - verticalMargins - rowAxis.fixedTotal();
+        verticalSpan = height / (this->rows - rowAxis.fixedCount());
+    }
 
+    const QTileAxis &columnAxis = this->columnAxis();
     int horizontalMargins = this->contentsMargins().left() + this->contentsMargins().right();
-    int horizontalSpan = (newSize.size().width() - (this->columns - 1) * this->horizontalSpacing() - horizontalMargins) / this->columns;
+    int horizontalSpan = this->horizontalSpan;
+    if (columnAxis.fixedCount() < this->columns) {
+        int width = size.width() - (this->columns - 1) * this->horizontalSpacing() - horizontalMargins - columnAxis.fixedTotal();
+        horizontalSpan = width / (this->columns - columnAxis.fixedCount());
+    }
+
+    verticalSpan = qMax(verticalSpan, this->minVerticalSpan);
+    horizontalSpan = qMax(horizontalSpan, this->minHorizontalSpan);
+    if ((verticalSpan == this->verticalSpan) && (horizontalSpan == this->horizontalSpan)) {
+        return;
+    }
 
-    this->verticalSpan = qMax(verticalSpan, this->minVerticalSpan);
-    this->horizontalSpan = qMax(horizontalSpan, this->minHorizontalSpan);
+    this->verticalSpan = verticalSpan;
+    this->horizontalSpan = horizontalSpan;
+    this->syncAxes();
     this->updateAllTiles();
 }
 
-void QTileLayout::init(const int rows, const int columns, const int verticalSpan, const int horizontalSpan, const int verticalSpacing, const int horizontalSpacing)
+void QTileLayout::init(const int rows, const int columns, const int verticalSpan, const int horizontalSpan, const int verticalSpacing, const int horizontalSpacing, const bool emptyCellMode)
 {
     Super::setVerticalSpacing(verticalSpacing);
     Super::setHorizontalSpacing(horizontalSpacing);
@@ -438,6 +1403,7 @@ void QTileLayout::init(const int rows, const int columns, const int verticalSpan
     this->colorIdle = QColor(240, 240, 240);
     this->colorResize = QColor(211, 211, 211);
     this->colorEmptyCheck = QColor(150, 150, 150);
+    this->colorSelected = QColor(0, 120, 215);
 
     this->cursorIdle = Qt::CursorShape::ArrowCursor;
     this->cursorGrab = Qt::CursorShape::OpenHandCursor;
@@ -446,31 +1412,152 @@ void QTileLayout::init(const int rows, const int columns, const int verticalSpan
 
     this->dragAndDrop = true;
     this->resizable = true;
+    this->selectable = false;
     this->focus = false;
+    this->emptyCellMode = emptyCellMode;
+    this->eventDispatch = false;
     this->widgetToDrop_ = nullptr;
+    this->widgetTiles_ = {};
     this->widgets_ = {};
-    this->tiles_ = {};
+    this->dragPixmaps_ = {};
+    this->selection_ = {};
+    this->updateDepth_ = 0;
+    this->pendingUpdateAllTiles_ = false;
+    this->pendingPlacements_ = {};
+    this->pendingRemovals_ = {};
+    this->scrollArea_ = nullptr;
+    this->virtualArea_ = QRect();
+    this->materializedTiles_ = {};
+    this->virtualizationEmptyCellMode_ = emptyCellMode;
+    this->dispatchWidget_ = nullptr;
+    this->tilePool_ = {};
+    this->tilePoolRequests_ = 0;
+    this->tilePoolHits_ = 0;
+    this->stats_ = QTileLayoutStats();
+    this->statsEnabled_ = false;
+    this->statsDepth_ = 0;
+    this->widgetFactories_ = {};
+    this->pendingFactories_ = {};
+    this->pendingGlobalSize_ = QSize();
+    this->traceDepth_ = 0;
+    this->traceWidgetIds_ = {};
+    this->rowAxis_ = QTileAxis();
+    this->columnAxis_ = QTileAxis();
+    this->baseColor_ = QColor();
+    this->highlightArea_ = QRect();
+    this->staleArea_ = QRect();
     this->id = QUuid::createUuid();
     this->linkedLayouts = {};
     this->linkedLayouts.insert(this->id, this);
 
+    this->background_ = new QTileBackground(this);
+
+    this->factoryTimer_ = new QTimer(this);
+    this->factoryTimer_->setSingleShot(true);
+    this->factoryTimer_->setInterval(0);
+    connect(this->factoryTimer_, &QTimer::timeout, this, &QTileLayout::buildPendingWidgets);
+
+    this->resizeTimer_ = new QTimer(this);
+    this->resizeTimer_->setSingleShot(true);
+    this->resizeTimer_->setTimerType(Qt::TimerType::PreciseTimer);
+    connect(this->resizeTimer_, &QTimer::timeout, this, &QTileLayout::applyGlobalSize);
+    this->background_->setCursor(this->cursorIdle);
+
     this->setRowStretch(this->rows, 1);
     this->setColumnStretch(this->columns, 1);
+    this->syncAxes();
+    this->updateBackground();
     this->initTileMap();
 }
 
+void QTileLayout::syncAxes(void)
+{
+    this->rowAxis_.resize(this->rows);
+    this->rowAxis_.setDefaultSize(this->verticalSpan);
+    this->rowAxis_.setSpacing(this->verticalSpacing());
+    this->columnAxis_.resize(this->columns);
+    this->columnAxis_.setDefaultSize(this->horizontalSpan);
+    this->columnAxis_.setSpacing(this->horizontalSpacing());
+}
+
 void QTileLayout::initTileMap(void)
 {
     this->tileMap_ = {};
+    this->grid_ = QTileGrid(this->rows, this->columns);
 
     for (int row = 0; row < this->rows; row++) {
         this->tileMap_.append(QList<QTileWidget*>());
         for (int column = 0; column < this->columns; column++) {
-            this->tileMap_[row].append(this->createTile(row, column));
+            this->tileMap_[row].append(this->emptyCellMode ? nullptr : this->createTile(row, column));
+        }
+        this->setRowMinimumHeight(row, this->rowHeight(row));
+    }
+    for (int column = 0; column < this->columns; column++) {
+        this->setColumnMinimumWidth(column, this->columnWidth(column));
+    }
+}
+
+void QTileLayout::updateBackground(void)
+{
+    this->gridMoveWidget(this->background_, 0, 0, this->rows, this->columns);
+    this->background_->resizeGrid(this->rows, this->columns, this->colorIdle);
+    this->resetTilesColor();
+}
+
+void QTileLayout::applyTilesColor(const QColor &baseColor, const QRect &area, const QColor &areaColor)
+{
+    QTILELAYOUT_STATS_SCOPE(ChangeTilesColor);
+    QRect grid(0, 0, this->columns, this->rows);
+    const QRect dirtyAreas[3] = {
+        (baseColor != this->baseColor_)? grid : this->highlightArea_,
+        area,
+        this->staleArea_
+    };
+    int dirtyCount = (baseColor != this->baseColor_)? 1 : 3;
+    this->baseColor_ = baseColor;
+    this->highlightArea_ = area.intersected(grid);
+    this->staleArea_ = QRect();
+
+    for (int index = 0; index < dirtyCount; index++) {
+        QRect cells = dirtyAreas[index].intersected(grid);
+        for (int row = cells.top(); row <= cells.bottom(); row++) {
+            for (int column = cells.left(); column <= cells.right(); column++) {
+                if (this->highlightArea_.contains(column, row)) {
+                    this->changeCellColor(row, column, areaColor);
+                } else {
+                    this->changeCellColor(row, column, baseColor);
+                }
+            }
         }
     }
 }
 
+void QTileLayout::changeCellColor(const int row, const int column, const QColor &color)
+{
+    QTILELAYOUT_STATS_COUNT(CellsRecolored, 1);
+    this->background_->setCellColor(row, column, this->isCellFilled(row, column)? this->colorIdle : color);
+}
+
+void QTileLayout::invalidateTilesColor(const int row, const int column, const int rowSpan, const int columnSpan)
+{
+    this->staleArea_ |= QRect(column, row, columnSpan, rowSpan).intersected(QRect(0, 0, this->columns, this->rows));
+}
+
+void QTileLayout::resetTilesColor(void)
+{
+    this->staleArea_ = QRect(0, 0, this->columns, this->rows);
+}
+
+QTileGrid::Key QTileLayout::gridKey(QWidget* const widget)
+{
+    return reinterpret_cast<QTileGrid::Key>(widget);
+}
+
+bool QTileLayout::isCellFilled(const int row, const int column)
+{
+    return this->grid_.isFilled(row, column);
+}
+
 QTileWidget* QTileLayout::createTile(const int row, const int column)
 {
     return this->createTile(row, column, 1, 1);
@@ -488,8 +1575,32 @@ QTileWidget* QTileLayout::createTile(const int row, const int column, const int
 
 QTileWidget* QTileLayout::createTile(const int row, const int column, const int rowSpan, const int columnSpan, const bool updateTileMap)
 {
-    QTileWidget* tile = new QTileWidget(this, row, column, rowSpan, columnSpan, this->verticalSpan, this->horizontalSpan);
-    Super::addWidget(tile, row, column, rowSpan, columnSpan);
+    QTileWidget* tile = nullptr;
+    this->tilePoolRequests_++;
+    if (this->tilePool_.isEmpty()) {
+        QTILELAYOUT_STATS_COUNT(TilesAllocated, 1);
+        tile = new QTileWidget(this, row, column, rowSpan, columnSpan);
+    } else {
+        QTILELAYOUT_STATS_COUNT(TilesReused, 1);
+        this->tilePoolHits_++;
+        tile = this->tilePool_.takeLast();
+        tile->updateSize(row, column, rowSpan, columnSpan);
+    }
+    tile->setMouseTracking(!this->eventDispatch);
+    if (this->eventDispatch) {
+        tile->unsetCursor();
+    }
+
+    if (this->scrollArea_ == nullptr) {
+        this->gridAddWidget(tile, row, column, rowSpan, columnSpan);
+        if (tile->parentWidget() != nullptr) {
+            tile->setVisible(true);
+        }
+    } else if (this->virtualArea_.intersects(QRect(column, row, columnSpan, rowSpan))) {
+        this->materializeTile(tile);
+    } else {
+        this->dematerializeTile(tile);
+    }
 
     if (updateTileMap == true) {
         for (int r = row; r < row + rowSpan; r++) {
@@ -497,176 +1608,328 @@ QTileWidget* QTileLayout::createTile(const int row, const int column, const int
                 this->tileMap_[r][c] = tile;
             }
         }
+        this->invalidateTilesColor(row, column, rowSpan, columnSpan);
     }
     return tile;
 }
 
-void QTileLayout::getTilesToBeResized(QTileWidget* const tile, QPair<int, int>* const direction, int &row, int &column, const int &tileCount, QSet<QPair<int, int> > &tilesToMerge, bool &increase, int &rowSpan, int &columnSpan)
+void QTileLayout::mergeTiles(QTileWidget* const tile, const QRect &from, const QRect &to)
 {
-    rowSpan = tile->getRowSpan();
-    columnSpan = tile->getColumnSpan();
-    increase = (tileCount * (direction->first + direction->second) > 0);
-
-    int tileAvailableCount = 0;
-    if (increase) {
-        this->getTilesToMerge(
-            direction,
-            row, column,
-            tileCount, tileAvailableCount,
-            tilesToMerge
-            );
-    } else {
-        this->getTilesToSplit(
-            direction,
-            row, column,
-            tileCount, tileAvailableCount,
-            tilesToMerge
-            );
+    for (int row = to.top(); row <= to.bottom(); row++) {
+        for (int column = to.left(); column <= to.right(); column++) {
+            if (from.contains(column, row)) {
+                continue;
+            }
+            QTileWidget *xTile = this->tileMap_[row][column];
+            if (xTile != nullptr) {
+                this->releaseTile(xTile);
+            }
+            this->tileMap_[row][column] = tile;
+        }
     }
 
-    rowSpan += tileAvailableCount * direction->second;
-    row += (direction->second == -1)? tileAvailableCount : 0;
-    columnSpan += tileAvailableCount * direction->first;
-    column += (direction->first == -1)? tileAvailableCount : 0;
+    this->gridMoveWidget(tile, to.y(), to.x(), to.height(), to.width());
+    tile->updateSize(to.y(), to.x(), to.height(), to.width());
+    this->invalidateTilesColor(to.y(), to.x(), to.height(), to.width());
 }
 
-void QTileLayout::getTilesToMerge(QPair<int, int>* const direction, const int &row, const int &column, const int &tileCount, int &tileAvailableCount, QSet<QPair<int, int> > &tilesToMerge)
+void QTileLayout::splitTiles(QTileWidget* const tile, const QRect &from, const QRect &to)
 {
-    QTileWidget *tile = this->tileMap_[row][column];
-    int rowSpan = tile->getRowSpan();
-    int columnSpan = tile->getColumnSpan();
-    tileAvailableCount = 0;
-    int swX = (direction->first != 0)? 1 : 0;
-    int swY = (direction->second != 0)? 1 : 0;
-
-    int tmpTileCount = (direction->first + direction->second == -1)?
-                           qMax<int>(tileCount, -column * swX - row * swY) :
-                           qMin<int>(tileCount, (this->columns - column - columnSpan) * swX + (this->rows - row - rowSpan) * swY);
-
-    if (direction->first != 0) {
-        int swP = (direction->first == 1)? 1 : 0;
-        int swN = (direction->first == -1)? 1 : 0;
-
-        for (int c = 0; c < tmpTileCount * direction->first; c++) {
-            QSet<QPair<int, int> > tilesToCheck;
-            int columnDelta = (columnSpan + c) * swP + (-c - 1) * swN;
-            for (int r = 0; r < rowSpan; r++) {
-                int rowCheck = row + r;
-                int columnCheck = column + columnDelta;
-                if (this->tileMap_[rowCheck][columnCheck]->isFilled()) {
-                    return;
-                }
-                tilesToCheck.insert(QPair<int, int>(rowCheck, columnCheck));
+    for (int row = from.top(); row <= from.bottom(); row++) {
+        for (int column = from.left(); column <= from.right(); column++) {
+            if (to.contains(column, row)) {
+                continue;
+            }
+            if (this->emptyCellMode) {
+                this->tileMap_[row][column] = nullptr;
+                this->invalidateTilesColor(row, column, 1, 1);
+            } else {
+                this->createTile(row, column, true);
             }
-            tileAvailableCount += direction->first;
-            tilesToMerge.unite(tilesToCheck);
         }
+    }
+    this->invalidateTilesColor(to.y(), to.x(), to.height(), to.width());
+    this->gridMoveWidget(tile, to.y(), to.x(), to.height(), to.width());
+    tile->updateSize(to.y(), to.x(), to.height(), to.width());
+}
+
+void QTileLayout::releaseTile(QTileWidget* const tile)
+{
+    this->gridRemoveWidget(tile);
+
+    if (
+        tile->isFilled() ||
+        tile->isDragInProcess() ||
+        (tile->parentWidget() == nullptr) ||
+        (this->tilePool_.size() >= this->tilePoolCapacity)
+        ) {
+        QTILELAYOUT_STATS_COUNT(TilesDeleted, 1);
+        tile->deleteLater();
     } else {
-        int swP = (direction->second == 1)? 1 : 0;
-        int swN = (direction->second == -1)? 1 : 0;
-
-        for (int r = 0; r < tileCount * direction->second; r++) {
-            QSet<QPair<int, int> > tilesToCheck;
-            int rowDelta = (rowSpan + r) * swP + (-r - 1) * swN;
-            for (int c = 0; c < columnSpan; c++) {
-                int rowCheck = row + rowDelta;
-                int columnCheck = column + c;
-                if (this->tileMap_[rowCheck][columnCheck]->isFilled()) {
-                    return;
-                }
-                tilesToCheck.insert(QPair<int, int>(rowCheck, columnCheck));
+        QTILELAYOUT_STATS_COUNT(TilesPooled, 1);
+        tile->setVisible(false);
+        this->tilePool_.append(tile);
+    }
+}
+
+QTileWidget* QTileLayout::hardSplitTiles(const int row, const int column, const QSet<QPair<int, int>> &tileToSplit)
+{
+    assert(tileToSplit.contains(QPair<int, int>(row, column)));
+
+    QSet<QTileWidget*> tileToRecycle;
+    QSetIterator<QPair<int, int> > splitItr(tileToSplit);
+    while (splitItr.hasNext()) {
+        QPair<int, int> xy = splitItr.next();
+        tileToRecycle.insert(this->tileMap_[xy.first][xy.second]);
+        if (this->emptyCellMode) {
+            this->tileMap_[xy.first][xy.second] = nullptr;
+            this->invalidateTilesColor(xy.first, xy.second, 1, 1);
+        } else {
+            this->createTile(xy.first, xy.second, true);
+        }
+    }
+
+    QSetIterator<QTileWidget*> recycleItr(tileToRecycle);
+    while (recycleItr.hasNext()) {
+        this->releaseTile(recycleItr.next());
+    }
+
+    QTileWidget* tile = this->tileMap_[row][column];
+    if (tile != nullptr) {
+        this->gridMoveWidget(tile, row, column, 1, 1);
+    }
+    return tile;
+}
+
+void QTileLayout::updateAllTiles(void)
+{
+    if (this->updateDepth_ > 0) {
+        this->pendingUpdateAllTiles_ = true;
+        return;
+    }
+    QTILELAYOUT_STATS_SCOPE(UpdateAllTiles);
+
+    for (int row = 0; row < this->rows; row++) {
+        for (int column = 0; column < this->columns; column++) {
+            QTileWidget *tile = this->tileMap_[row][column];
+            if ((tile != nullptr) && (tile->getRow() == row) && (tile->getColumn() == column)) {
+                tile->updateSize();
             }
-            tileAvailableCount += direction->second;
-            tilesToMerge.unite(tilesToCheck);
         }
+        this->setRowMinimumHeight(row, this->rowHeight(row));
     }
+    for (int column = 0; column < this->columns; column++) {
+        this->setColumnMinimumWidth(column, this->columnWidth(column));
+    }
+    this->background_->update();
+    this->updateVirtualization();
 }
 
-void QTileLayout::getTilesToSplit(QPair<int, int>* const direction, const int &row, const int &column, const int &tileCount, int &tileAvailableCount, QSet<QPair<int, int> > &tilesToSplit)
+void QTileLayout::gridAddWidget(QWidget* const widget, const int row, const int column, const int rowSpan, const int columnSpan)
 {
-    QTileWidget *tile = this->tileMap_[row][column];
-    int rowSpan = tile->getRowSpan();
-    int columnSpan = tile->getColumnSpan();
+    if (this->updateDepth_ > 0) {
+        this->pendingRemovals_.remove(widget);
+        this->pendingPlacements_.insert(widget, QRect(column, row, columnSpan, rowSpan));
+    } else {
+        Super::addWidget(widget, row, column, rowSpan, columnSpan);
+    }
+}
+
+void QTileLayout::gridMoveWidget(QWidget* const widget, const int row, const int column, const int rowSpan, const int columnSpan)
+{
+    if (this->updateDepth_ > 0) {
+        this->gridAddWidget(widget, row, column, rowSpan, columnSpan);
+    } else {
+        Super::removeWidget(widget);
+        Super::addWidget(widget, row, column, rowSpan, columnSpan);
+    }
+}
 
-    int swX0 = (direction->first != 0)? 1 : 0;
-    int swY0 = (direction->second != 0)? 1 : 0;
-    int swX1 = (direction->first == 1)? 1 : 0;
-    int swY1 = (direction->second == 1)? 1 : 0;
+void QTileLayout::gridRemoveWidget(QWidget* const widget)
+{
+    if (this->updateDepth_ > 0) {
+        this->pendingPlacements_.remove(widget);
+        this->pendingRemovals_.insert(widget);
+    } else {
+        Super::removeWidget(widget);
+    }
+    this->materializedTiles_.remove(widget);
+}
 
-    if (-tileCount * (direction->first + direction->second) < columnSpan * swX0 + rowSpan * swY0) {
-        tileAvailableCount = tileCount;
+void QTileLayout::updateVirtualization(void)
+{
+    if ((this->scrollArea_ == nullptr) || (this->updateDepth_ > 0)) {
+        return;
+    }
+
+    QWidget *parent = this->parentWidget();
+    QWidget *viewport = this->scrollArea_->viewport();
+    if ((parent == nullptr) || !viewport->isAncestorOf(parent)) {
+        this->virtualArea_ = QRect(0, 0, this->columns, this->rows);
     } else {
-        tileAvailableCount = (1 - columnSpan) * direction->first + (1 - rowSpan) * direction->second;
+        QRect visibleRect(parent->mapFrom(viewport, QPoint(0, 0)), viewport->size());
+        visibleRect.adjust(
+            -this->virtualizationMargin, -this->virtualizationMargin,
+            this->virtualizationMargin, this->virtualizationMargin
+            );
+        this->virtualArea_ = this->background_->cellsIn(visibleRect.translated(-this->background_->pos()));
     }
-    for (int r = 0; r < -tileCount * direction->second + rowSpan * swX0; r++) {
-        for (int c = 0; c < -tileCount * direction->first + columnSpan * swY0; c++) {
-            tilesToSplit.insert(QPair<int, int>(
-                row + r + (rowSpan - 2 * r - 1) * swY1,
-                column + c + (columnSpan - 2 * c - 1) * swX1
-                ));
+
+    QSet<QWidget*> visibleTiles;
+    for (int row = this->virtualArea_.top(); row <= this->virtualArea_.bottom(); row++) {
+        for (int column = this->virtualArea_.left(); column <= this->virtualArea_.right(); column++) {
+            QTileWidget *tile = this->tileMap_[row][column];
+            if (tile != nullptr) {
+                visibleTiles.insert(tile);
+            }
+        }
+    }
+
+    const QSet<QWidget*> materializedTiles = this->materializedTiles_;
+    this->beginUpdate();
+    for (QWidget *tile : materializedTiles) {
+        if (!visibleTiles.contains(tile)) {
+            this->dematerializeTile(static_cast<QTileWidget*>(tile));
+        }
+    }
+    for (QWidget *tile : visibleTiles) {
+        if (!materializedTiles.contains(tile)) {
+            this->materializeTile(static_cast<QTileWidget*>(tile));
         }
     }
+    this->endUpdate();
+    this->materializedTiles_ = visibleTiles;
 }
 
-void QTileLayout::mergeTiles(QTileWidget* const tile, const int row, const int column, const int rowSpan, const int columnSpan, const QSet<QPair<int, int> > &tilesToMerge)
+void QTileLayout::buildPendingWidgets(void)
 {
-    QSetIterator<QPair<int, int> > itr(tilesToMerge);
-    while (itr.hasNext()) {
-        QPair<int, int> xy = itr.next();
-        QTileWidget *xTile = this->tileMap_[xy.first][xy.second];
-        Super::removeWidget(xTile);
-        xTile->deleteLater();
-        this->tileMap_[xy.first][xy.second] = tile;
+    QElapsedTimer timer;
+    timer.start();
+    while (!this->pendingFactories_.isEmpty() && !timer.hasExpired(this->factoryTimeBudget)) {
+        this->buildWidget(this->pendingFactories_.first());
     }
 
-    Super::removeWidget(tile);
-    Super::addWidget(tile, row, column, rowSpan, columnSpan);
-    tile->updateSize(row, column, rowSpan, columnSpan);
+    if (!this->pendingFactories_.isEmpty()) {
+        this->factoryTimer_->start();
+    }
 }
 
-void QTileLayout::splitTiles(QTileWidget* const tile, const int row, const int column, const int rowSpan, const int columnSpan, const QSet<QPair<int, int> > &tilesToSplit)
+void QTileLayout::buildWidget(QWidget* const placeholder)
 {
-    QSetIterator<QPair<int, int> > itr(tilesToSplit);
-    while (itr.hasNext()) {
-        QPair<int, int> xy = itr.next();
-        this->createTile(xy.first, xy.second, true);
+    std::function<QWidget*(void)> factory = this->widgetFactories_.take(placeholder);
+    this->pendingFactories_.removeOne(placeholder);
+    placeholder->removeEventFilter(this);
+    if (!this->widgetTiles_.contains(placeholder)) {
+        return;
+    }
+
+    QWidget *widget = factory();
+    assert(widget != nullptr);
+    assert(!this->widgetTiles_.contains(widget));
+
+    QTileWidget *tile = this->widgetTiles_.take(placeholder);
+    QRect area = this->grid_.area(this->gridKey(placeholder));
+    this->grid_.remove(this->gridKey(placeholder));
+    this->grid_.place(this->gridKey(widget), area);
+    tile->removeWidget();
+    placeholder->setMouseTracking(false);
+    placeholder->setParent(nullptr);
+    placeholder->deleteLater();
+
+    widget->setMouseTracking(!this->eventDispatch);
+    tile->addWidget(widget);
+    this->widgetTiles_.insert(widget, tile);
+    this->widgets_[this->widgets_.indexOf(placeholder)] = widget;
+    int selectionIndex = this->selection_.indexOf(placeholder);
+    if (selectionIndex >= 0) {
+        this->selection_[selectionIndex] = widget;
+    }
+    if (this->widgetToDrop_ == placeholder) {
+        this->setWidgetToDrop(widget);
     }
-    Super::removeWidget(tile);
-    Super::addWidget(tile, row, column, rowSpan, columnSpan);
-    tile->updateSize(row, column, rowSpan, columnSpan);
+    emit this->widgetBuilt(placeholder, widget);
 }
 
-QTileWidget* QTileLayout::hardSplitTiles(const int row, const int column, const QSet<QPair<int, int>> &tileToSplit)
+bool QTileLayout::eventFilter(QObject *watched, QEvent *event)
 {
-    assert(tileToSplit.contains(QPair<int, int>(row, column)));
+    if ((event->type() == QEvent::Paint) && !this->widgetFactories_.isEmpty()) {
+        QWidget *placeholder = qobject_cast<QWidget*>(watched);
+        if (this->widgetFactories_.contains(placeholder) && (this->pendingFactories_.first() != placeholder)) {
+            this->pendingFactories_.removeOne(placeholder);
+            this->pendingFactories_.prepend(placeholder);
+            this->factoryTimer_->start(0);
+        }
+    }
+    if (
+        (this->scrollArea_ != nullptr) &&
+        (watched == this->scrollArea_->viewport()) &&
+        (event->type() == QEvent::Resize)
+        ) {
+        this->updateVirtualization();
+    }
+    if (
+        (this->dispatchWidget_ != nullptr) &&
+        (event->type() == QEvent::MouseMove) &&
+        watched->isWidgetType() &&
+        (static_cast<QMouseEvent*>(event)->buttons() == Qt::MouseButton::NoButton)
+        ) {
+        QWidget *widget = static_cast<QWidget*>(watched);
+        if ((widget == this->dispatchWidget_) || this->dispatchWidget_->isAncestorOf(widget)) {
+            QPoint position = static_cast<QMouseEvent*>(event)->position().toPoint();
+            this->updateHoverCursor(widget->mapTo(this->dispatchWidget_, position));
+        }
+    }
+    return Super::eventFilter(watched, event);
+}
 
-    QSet<QTileWidget*> tileToRecycle;
-    QSetIterator<QPair<int, int> > splitItr(tileToSplit);
-    while (splitItr.hasNext()) {
-        QPair<int, int> xy = splitItr.next();
-        tileToRecycle.insert(this->tileMap_[xy.first][xy.second]);
-        this->createTile(xy.first, xy.second, true);
+void QTileLayout::updateHoverCursor(const QPoint &position)
+{
+    Qt::CursorShape cursor = this->cursorIdle;
+    int row, column;
+    if (this->background_->cellAt(position - this->background_->pos(), row, column)) {
+        QTileWidget *tile = this->tileMap_[row][column];
+        if ((tile != nullptr) && tile->isVisible()) {
+            cursor = tile->cursorAt(position - tile->pos());
+        }
     }
 
-    QSetIterator<QTileWidget*> recycleItr(tileToRecycle);
-    while (recycleItr.hasNext()) {
-        QTileWidget *rmTile = recycleItr.next();
-        Super::removeWidget(rmTile);
-        rmTile->deleteLater();
+    if (this->dispatchWidget_->cursor().shape() != cursor) {
+        this->dispatchWidget_->setCursor(cursor);
     }
+}
 
-    QTileWidget* tile = this->tileMap_[row][column];
-    Super::addWidget(tile, row, column);
-    return tile;
+void QTileLayout::materializeTile(QTileWidget* const tile)
+{
+    int row = tile->getRow();
+    int column = tile->getColumn();
+    int rowSpan = tile->getRowSpan();
+    int columnSpan = tile->getColumnSpan();
+
+    this->gridAddWidget(tile, row, column, rowSpan, columnSpan);
+    this->materializedTiles_.insert(tile);
+    if (this->parentWidget() != nullptr) {
+        if (tile->parentWidget() != this->parentWidget()) {
+            tile->setParent(this->parentWidget());
+        }
+        tile->setGeometry(this->background_->areaRect(row, column, rowSpan, columnSpan).translated(this->background_->pos()));
+        tile->setVisible(true);
+    }
+    if (tile->getWidget() != nullptr) {
+        emit this->widgetMaterialized(tile->getWidget());
+    }
 }
 
-void QTileLayout::updateAllTiles(void)
+void QTileLayout::dematerializeTile(QTileWidget* const tile)
 {
-    QListIterator<QList<QTileWidget*> > tileMapRowItr(this->tileMap_);
-    while (tileMapRowItr.hasNext()) {
-        QListIterator<QTileWidget*> tileMapRowColItr(tileMapRowItr.next());
-        while (tileMapRowColItr.hasNext()) {
-            tileMapRowColItr.next()->updateSize(this->verticalSpan, this->horizontalSpan);
+    this->gridRemoveWidget(tile);
+    if (this->parentWidget() != nullptr) {
+        if (tile->parentWidget() != this->parentWidget()) {
+            tile->setParent(this->parentWidget());
         }
+        tile->setVisible(false);
+    }
+    if (tile->getWidget() != nullptr) {
+        emit this->widgetDematerialized(tile->getWidget());
     }
 }
+
@@ -0,0 +1,113 @@
+#include "QTileLayout/qtilelayoutstats.h"
+#include "QTileLayout/qtilelayout.h"
+#include <algorithm>
+
+
+QTileLayoutStats::QTileLayoutStats(void)
+{
+    this->reset();
+}
+
+void QTileLayoutStats::reset(void)
+{
+    this->counters_ = QList<qint64>(CounterCount, 0);
+    this->timings_ = QList<Timing>(OperationCount, Timing{0, 0, 0, {}, 0});
+}
+
+void QTileLayoutStats::increment(const Counter counter, const qint64 amount)
+{
+    this->counters_[counter] += amount;
+}
+
+void QTileLayoutStats::record(const Operation operation, const qint64 nsecs)
+{
+    Timing &timing = this->timings_[operation];
+    timing.count++;
+    timing.total += nsecs;
+    timing.maximum = qMax(timing.maximum, nsecs);
+
+    if (timing.samples.size() < this->SAMPLE_CAPACITY) {
+        if (timing.samples.isEmpty()) {
+            timing.samples.reserve(this->SAMPLE_CAPACITY);
+        }
+        timing.samples.append(nsecs);
+    } else {
+        timing.samples[timing.nextSample] = nsecs;
+        timing.nextSample = (timing.nextSample + 1) % this->SAMPLE_CAPACITY;
+    }
+}
+
+qint64 QTileLayoutStats::count(const Counter counter) const
+{
+    return this->counters_[counter];
+}
+
+qint64 QTileLayoutStats::operationCount(const Operation operation) const
+{
+    return this->timings_[operation].count;
+}
+
+qint64 QTileLayoutStats::totalTime(const Operation operation) const
+{
+    return this->timings_[operation].total;
+}
+
+qint64 QTileLayoutStats::maximumTime(const Operation operation) const
+{
+    return this->timings_[operation].maximum;
+}
+
+qint64 QTileLayoutStats::percentileTime(const Operation operation, const qreal percentile) const
+{
+    assert((0 <= percentile) && (percentile <= 100));
+
+    QList<qint64> samples = this->timings_[operation].samples;
+    if (samples.isEmpty()) {
+        return 0;
+    }
+
+    int index = qMin(int(percentile / 100 * samples.size()), int(samples.size()) - 1);
+    std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+    return samples[index];
+}
+
+QString QTileLayoutStats::counterName(const Counter counter)
+{
+    static const QList<QString> names = {
+        "tilesAllocated", "tilesReused", "tilesPooled", "tilesDeleted", "cellsRecolored"
+    };
+    return names.value(counter);
+}
+
+QString QTileLayoutStats::operationName(const Operation operation)
+{
+    static const QList<QString> names = {
+        "addWidget", "addWidgets", "removeWidget", "resizeTile", "dropWidget",
+        "addRows", "addColumns", "removeRows", "removeColumns", "restoreState", "compact",
+        "applyGrid", "moveSelection", "resizeSelection", "updateAllTiles", "updateGlobalSize", "changeTilesColor"
+    };
+    return names.value(operation);
+}
+
+QTileLayoutStatsScope::QTileLayoutStatsScope(QTileLayout* const tileLayout, const QTileLayoutStats::Operation operation)
+{
+    this->tileLayout_ = tileLayout->statsEnabled_ ? tileLayout : nullptr;
+    this->operation_ = operation;
+    if (this->tileLayout_ != nullptr) {
+        this->tileLayout_->statsDepth_++;
+        this->timer_.start();
+    }
+}
+
+QTileLayoutStatsScope::~QTileLayoutStatsScope(void)
+{
+    if (this->tileLayout_ == nullptr) {
+        return;
+    }
+
+    this->tileLayout_->stats_.record(this->operation_, this->timer_.nsecsElapsed());
+    this->tileLayout_->statsDepth_--;
+    if (this->tileLayout_->statsDepth_ == 0) {
+        emit this->tileLayout_->statsUpdated(this->tileLayout_->stats_);
+    }
+}
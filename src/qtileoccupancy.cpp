@@ -0,0 +1,242 @@
+#include "QTileLayout/qtileoccupancy.h"
+
+
+QTileOccupancy::QTileOccupancy(void)
+    : QTileOccupancy(0, 0)
+{
+}
+
+QTileOccupancy::QTileOccupancy(const int rows, const int columns)
+{
+    this->rows_ = 0;
+    this->columns_ = 0;
+    this->words_ = 0;
+    this->bits_ = {};
+    this->longestRuns_ = {};
+    this->prefixSums_ = {};
+    this->prefixSumsValid_ = false;
+    this->resize(rows, columns);
+}
+
+void QTileOccupancy::resize(const int rows, const int columns)
+{
+    int words = (columns + 63) / 64;
+    QList<quint64> bits(rows * words, 0);
+
+    int copyRows = qMin(rows, this->rows_);
+    int copyWords = qMin(words, this->words_);
+    for (int r = 0; r < copyRows; r++) {
+        for (int w = 0; w < copyWords; w++) {
+            bits[r * words + w] = this->bits_[r * this->words_ + w];
+        }
+        if ((columns < this->columns_) && (columns % 64 != 0)) {
+            bits[r * words + words - 1] &= this->wordMask(0, columns % 64);
+        }
+    }
+
+    this->rows_ = rows;
+    this->columns_ = columns;
+    this->words_ = words;
+    this->bits_ = bits;
+    this->longestRuns_ = QList<int>(rows, 0);
+    for (int r = 0; r < rows; r++) {
+        this->longestRuns_[r] = this->longestFreeRun(r);
+    }
+    this->prefixSumsValid_ = false;
+}
+
+void QTileOccupancy::setArea(const int row, const int column, const int rowSpan, const int columnSpan, const bool filled)
+{
+    int firstWord = column / 64;
+    int lastWord = (column + columnSpan - 1) / 64;
+
+    for (int r = row; r < row + rowSpan; r++) {
+        for (int w = firstWord; w <= lastWord; w++) {
+            int from = (w == firstWord)? column % 64 : 0;
+            int to = (w == lastWord)? (column + columnSpan - 1) % 64 + 1 : 64;
+            quint64 &word = this->bits_[r * this->words_ + w];
+            if (filled) {
+                word |= this->wordMask(from, to);
+            } else {
+                word &= ~this->wordMask(from, to);
+            }
+        }
+        this->longestRuns_[r] = this->longestFreeRun(r);
+    }
+    this->prefixSumsValid_ = false;
+}
+
+bool QTileOccupancy::isFilled(const int row, const int column) const
+{
+    return (this->bits_[row * this->words_ + column / 64] >> (column % 64)) & 1;
+}
+
+bool QTileOccupancy::isAreaEmpty(const int row, const int column, const int rowSpan, const int columnSpan) const
+{
+    if (!this->prefixSumsValid_) {
+        int wordSpan = (column + columnSpan - 1) / 64 - column / 64 + 1;
+        if (rowSpan * wordSpan <= this->SCAN_WORD_LIMIT) {
+            return this->isAreaEmptyScan(row, column, rowSpan, columnSpan);
+        }
+    }
+    return this->filledCount(row, column, rowSpan, columnSpan) == 0;
+}
+
+int QTileOccupancy::filledCount(const int row, const int column, const int rowSpan, const int columnSpan) const
+{
+    if (!this->prefixSumsValid_) {
+        this->updatePrefixSums();
+    }
+
+    int stride = this->columns_ + 1;
+    return this->prefixSums_[(row + rowSpan) * stride + column + columnSpan]
+           - this->prefixSums_[row * stride + column + columnSpan]
+           - this->prefixSums_[(row + rowSpan) * stride + column]
+           + this->prefixSums_[row * stride + column];
+}
+
+bool QTileOccupancy::findFreeArea(const int rowSpan, const int columnSpan, int &row, int &column, const bool bestFit) const
+{
+    assert((rowSpan > 0) && (columnSpan > 0));
+
+    int bestWaste = -1;
+    QList<quint64> mask(this->words_, 0);
+    int r = 0;
+    while (r + rowSpan <= this->rows_) {
+        int blocked = r + rowSpan - 1;
+        while ((blocked >= r) && (this->longestRuns_[blocked] >= columnSpan)) {
+            blocked--;
+        }
+        if (blocked >= r) {
+            r = blocked + 1;
+            continue;
+        }
+
+        this->freeMask(r, rowSpan, mask);
+
+        int c = 0;
+        while (c < this->columns_) {
+            int start = this->nextBit(mask, c, true);
+            if (start >= this->columns_) {
+                break;
+            }
+            int end = this->nextBit(mask, start, false);
+            int waste = end - start - columnSpan;
+            if ((waste >= 0) && ((bestWaste < 0) || (waste < bestWaste))) {
+                row = r;
+                column = start;
+                bestWaste = waste;
+                if (!bestFit || (waste == 0)) {
+                    return true;
+                }
+            }
+            c = end;
+        }
+        r++;
+    }
+    return bestWaste >= 0;
+}
+
+int QTileOccupancy::rowCount(void) const
+{
+    return this->rows_;
+}
+
+int QTileOccupancy::columnCount(void) const
+{
+    return this->columns_;
+}
+
+void QTileOccupancy::updatePrefixSums(void) const
+{
+    int stride = this->columns_ + 1;
+    this->prefixSums_.fill(0, (this->rows_ + 1) * stride);
+
+    for (int r = 0; r < this->rows_; r++) {
+        int rowSum = 0;
+        for (int c = 0; c < this->columns_; c++) {
+            rowSum += this->isFilled(r, c)? 1 : 0;
+            this->prefixSums_[(r + 1) * stride + c + 1] = this->prefixSums_[r * stride + c + 1] + rowSum;
+        }
+    }
+    this->prefixSumsValid_ = true;
+}
+
+int QTileOccupancy::longestFreeRun(const int row) const
+{
+    int longest = 0;
+    int run = 0;
+    for (int w = 0; w < this->words_; w++) {
+        quint64 word = this->bits_[row * this->words_ + w];
+        int width = qMin(64, this->columns_ - w * 64);
+        int c = 0;
+        while (c < width) {
+            quint64 rest = word >> c;
+            if (rest & 1) {
+                longest = qMax(longest, run);
+                run = 0;
+                c += qCountTrailingZeroBits(~rest);
+            } else {
+                int zeros = (rest == 0)? width - c : qMin(int(qCountTrailingZeroBits(rest)), width - c);
+                run += zeros;
+                c += zeros;
+            }
+        }
+    }
+    return qMax(longest, run);
+}
+
+bool QTileOccupancy::isAreaEmptyScan(const int row, const int column, const int rowSpan, const int columnSpan) const
+{
+    int firstWord = column / 64;
+    int lastWord = (column + columnSpan - 1) / 64;
+
+    for (int r = row; r < row + rowSpan; r++) {
+        for (int w = firstWord; w <= lastWord; w++) {
+            int from = (w == firstWord)? column % 64 : 0;
+            int to = (w == lastWord)? (column + columnSpan - 1) % 64 + 1 : 64;
+            if (this->bits_[r * this->words_ + w] & this->wordMask(from, to)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void QTileOccupancy::freeMask(const int row, const int rowSpan, QList<quint64> &mask) const
+{
+    for (int w = 0; w < this->words_; w++) {
+        quint64 word = ~quint64(0);
+        for (int r = row; r < row + rowSpan; r++) {
+            word &= ~this->bits_[r * this->words_ + w];
+        }
+        mask[w] = word;
+    }
+    if (this->columns_ % 64 != 0) {
+        mask[this->words_ - 1] &= this->wordMask(0, this->columns_ % 64);
+    }
+}
+
+int QTileOccupancy::nextBit(const QList<quint64> &mask, const int from, const bool value) const
+{
+    int w = from / 64;
+    if (w >= this->words_) {
+        return this->columns_;
+    }
+
+    quint64 word = (value ? mask[w] : ~mask[w]) & this->wordMask(from % 64, 64);
+    while (word == 0) {
+        w++;
+        if (w >= this->words_) {
+            return this->columns_;
+        }
+        word = value ? mask[w] : ~mask[w];
+    }
+    return qMin(w * 64 + qCountTrailingZeroBits(word), this->columns_);
+}
+
+quint64 QTileOccupancy::wordMask(const int from, const int to)
+{
+    quint64 upper = (to >= 64)? ~quint64(0) : ((quint64(1) << to) - 1);
+    return upper & ~((quint64(1) << from) - 1);
+}
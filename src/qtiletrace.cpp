@@ -0,0 +1,144 @@
+#include "QTileLayout/qtiletrace.h"
+#include "QTileLayout/qtilelayout.h"
+
+
+QTileTrace::QTileTrace(void)
+{
+    this->stream_.setVersion(QDataStream::Qt_6_0);
+}
+
+void QTileTrace::setDevice(QIODevice* const device)
+{
+    this->stream_.setDevice(device);
+    this->stream_.resetStatus();
+    this->timer_.start();
+}
+
+QIODevice* QTileTrace::device(void)
+{
+    return this->stream_.device();
+}
+
+void QTileTrace::writeHeader(const Header &header)
+{
+    this->stream_ << this->MAGIC << this->VERSION;
+    this->stream_ << header.rows << header.columns;
+    this->stream_ << header.verticalSpan << header.horizontalSpan;
+    this->stream_ << header.verticalSpacing << header.horizontalSpacing;
+    this->stream_ << header.emptyCellMode;
+    for (qint32 height : header.rowHeights) {
+        this->stream_ << height;
+    }
+    for (qint32 width : header.columnWidths) {
+        this->stream_ << width;
+    }
+    this->stream_ << quint32(header.widgets.size());
+    for (const QPair<qint32, QRect> &widget : header.widgets) {
+        this->stream_ << widget.first;
+        this->stream_ << qint32(widget.second.y()) << qint32(widget.second.x());
+        this->stream_ << qint32(widget.second.height()) << qint32(widget.second.width());
+    }
+}
+
+void QTileTrace::writeRecord(const Operation operation, const QList<qint32> &arguments)
+{
+    assert(arguments.size() <= 255);
+
+    this->stream_ << quint8(operation) << qint64(this->timer_.nsecsElapsed()) << quint8(arguments.size());
+    for (qint32 argument : arguments) {
+        this->stream_ << argument;
+    }
+}
+
+bool QTileTrace::readHeader(Header &header)
+{
+    quint32 magic;
+    quint16 version;
+    this->stream_ >> magic >> version;
+    if ((this->stream_.status() != QDataStream::Ok) || (magic != this->MAGIC) || (version < 1) || (version > this->VERSION)) {
+        return false;
+    }
+
+    quint32 count;
+    this->stream_ >> header.rows >> header.columns;
+    this->stream_ >> header.verticalSpan >> header.horizontalSpan;
+    this->stream_ >> header.verticalSpacing >> header.horizontalSpacing;
+    this->stream_ >> header.emptyCellMode;
+
+    header.rowHeights = {};
+    header.columnWidths = {};
+    if (version >= 2) {
+        for (qint32 row = 0; (row < header.rows) && (this->stream_.status() == QDataStream::Ok); row++) {
+            qint32 height;
+            this->stream_ >> height;
+            header.rowHeights.append(height);
+        }
+        for (qint32 column = 0; (column < header.columns) && (this->stream_.status() == QDataStream::Ok); column++) {
+            qint32 width;
+            this->stream_ >> width;
+            header.columnWidths.append(width);
+        }
+    }
+    this->stream_ >> count;
+
+    header.widgets = {};
+    for (quint32 index = 0; (index < count) && (this->stream_.status() == QDataStream::Ok); index++) {
+        qint32 id, row, column, rowSpan, columnSpan;
+        this->stream_ >> id >> row >> column >> rowSpan >> columnSpan;
+        header.widgets.append({id, QRect(column, row, columnSpan, rowSpan)});
+    }
+    return this->stream_.status() == QDataStream::Ok;
+}
+
+bool QTileTrace::readRecord(Record &record)
+{
+    if (this->stream_.atEnd()) {
+        return false;
+    }
+
+    quint8 operation, count;
+    this->stream_ >> operation >> record.timestamp >> count;
+    if ((this->stream_.status() != QDataStream::Ok) || (operation >= OperationCount)) {
+        return false;
+    }
+
+    record.operation = Operation(operation);
+    record.arguments = QList<qint32>(count, 0);
+    for (qint32 &argument : record.arguments) {
+        this->stream_ >> argument;
+    }
+    return this->stream_.status() == QDataStream::Ok;
+}
+
+QString QTileTrace::operationName(const Operation operation)
+{
+    static const QList<QString> names = {
+        "addWidget", "removeWidget", "resizeTile", "dropWidget", "updateGlobalSize",
+        "addRows", "addColumns", "removeRows", "removeColumns", "compact",
+        "moveSelection", "resizeSelection", "selectWidgets", "setRowHeight", "setColumnWidth"
+    };
+    return names.value(operation);
+}
+
+QTileTraceScope::QTileTraceScope(QTileLayout* const tileLayout, const QTileTrace::Operation operation)
+{
+    this->tileLayout_ = tileLayout;
+    this->operation_ = operation;
+    this->recording_ = (tileLayout->trace_.device() != nullptr) && (tileLayout->traceDepth_ == 0);
+    this->tileLayout_->traceDepth_++;
+}
+
+QTileTraceScope::~QTileTraceScope(void)
+{
+    this->tileLayout_->traceDepth_--;
+}
+
+bool QTileTraceScope::isRecording(void)
+{
+    return this->recording_;
+}
+
+void QTileTraceScope::record(const QList<qint32> &arguments)
+{
+    this->tileLayout_->trace_.writeRecord(this->operation_, arguments);
+}
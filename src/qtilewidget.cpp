@@ -1,23 +1,22 @@
 #include "QTileLayout/qtilelayout.h"
 #include "QTileLayout/qtilewidget.h"
+#include "QTileLayout/qtiledropdata.h"
 
 
-QTileWidget::QTileWidget(QTileLayout* const tileLayout, const int row, const int column, const int rowSpan, const int columnSpan, const int verticalSpan, const int horizontalSpan, QWidget* const parent)
+QTileWidget::QTileWidget(QTileLayout* const tileLayout, const int row, const int column, const int rowSpan, const int columnSpan, QWidget* const parent)
     : QWidget{parent}
 {
     this->tileLayout_ = tileLayout;
-    this->originTileLayout_ = this->tileLayout_;
     this->row_ = row;
     this->column_ = column;
     this->rowSpan_ = rowSpan;
     this->columnSpan_ = columnSpan;
-    this->verticalSpan_ = verticalSpan;
-    this->horizontalSpan_ = horizontalSpan;
     this->resizeMargin_ = 5;
 
     this->filled_ = false;
     this->widget_ = nullptr;
-    this->lock_ = nullptr;
+    this->lock_ = QPair<int, int>(0, 0);
+    this->resizeExtent_ = 0;
     this->dragInProcess_ = false;
     this->currentTileCount_ = 0;
 
@@ -26,7 +25,9 @@ QTileWidget::QTileWidget(QTileLayout* const tileLayout, const int row, const int
     layout->setContentsMargins(0, 0, 0, 0);
     this->setLayout(layout);
 
-    this->mouseMovePos_ = nullptr;
+    this->mouseMovePos_ = QPoint();
+    this->mousePressed_ = false;
+    this->dragPixmapScale_ = 1;
     this->updateSizeLimit();
     this->setAcceptDrops(true);
     this->setMouseTracking(true);
@@ -36,11 +37,10 @@ void QTileWidget::addWidget(QWidget* const widget) {
     this->layout()->addWidget(widget);
     this->widget_ = widget;
     this->filled_ = true;
+    widget->installEventFilter(this);
 }
 
-void QTileWidget::updateSize(const int verticalSpan, const int horizontalSpan) {
-    this->verticalSpan_ = verticalSpan;
-    this->horizontalSpan_ = horizontalSpan;
+void QTileWidget::updateSize(void) {
     this->updateSizeLimit();
 }
 
@@ -52,18 +52,6 @@ void QTileWidget::updateSize(const int row, const int column, const int rowSpan,
     this->updateSizeLimit();
 }
 
-void QTileWidget::updateSize(const int row, const int column, const int rowSpan, const int columnSpan, const int verticalSpan, const int horizontalSpan) {
-    this->verticalSpan_ = verticalSpan;
-    this->horizontalSpan_ = horizontalSpan;
-    this->updateSize(row, column, rowSpan, columnSpan);
-}
-
-void QTileWidget::changeColor(const QPalette &palette)
-{
-    this->setAutoFillBackground(true);
-    this->setPalette(palette);
-}
-
 int QTileWidget::getRow(void)
 {
     return this->row_;
@@ -84,17 +72,52 @@ int QTileWidget::getColumnSpan(void)
     return this->columnSpan_;
 }
 
+QWidget* QTileWidget::getWidget(void)
+{
+    return this->widget_;
+}
+
 bool QTileWidget::isFilled(void)
 {
     return this->filled_;
 }
 
+bool QTileWidget::isDragInProcess(void)
+{
+    return this->dragInProcess_;
+}
+
+Qt::CursorShape QTileWidget::cursorAt(const QPoint &position)
+{
+    if (!this->filled_) {
+        return this->tileLayout_->cursorIdle;
+    }
+
+    bool leftCondition = (0 <= position.x()) && (position.x() < this->resizeMargin_);
+    bool rightCondition = (this->width() >= position.x()) && (position.x() > this->width() - this->resizeMargin_);
+    bool topCondition = (0 <= position.y()) && (position.y() < this->resizeMargin_);
+    bool bottomCondition = (this->height() >= position.y()) && (position.y() > this->height() - this->resizeMargin_);
+
+    if ((leftCondition || rightCondition) && this->tileLayout_->resizable) {
+        return this->tileLayout_->cursorResizeH;
+    } else if ((topCondition|| bottomCondition) && this->tileLayout_->resizable) {
+        return this->tileLayout_->cursorResizeV;
+    } else if (this->tileLayout_->dragAndDrop && this->rect().contains(position)) {
+        return this->tileLayout_->cursorGrab;
+    }
+    return this->tileLayout_->cursorIdle;
+}
+
 void QTileWidget::mouseMoveEvent(QMouseEvent *event)
 {
+    if (this->tileLayout_->eventDispatch && (event->buttons() == Qt::MouseButton::NoButton)) {
+        return Super::mouseMoveEvent(event);
+    }
+
     if (event->buttons() == Qt::MouseButton::LeftButton) {
-        if (this->mouseMovePos_ != nullptr && !this->dragInProcess_ && this->lock_ == nullptr) {
+        if (this->mousePressed_ && !this->dragInProcess_ && !this->isLocked()) {
             QPointF globalPos = event->globalPosition();
-            QPointF lastPos = this->mapToGlobal(QPointF(*this->mouseMovePos_));
+            QPointF lastPos = this->mapToGlobal(QPointF(this->mouseMovePos_));
             QPointF diff = globalPos - lastPos;
 
             if (
@@ -120,29 +143,15 @@ void QTileWidget::mouseMoveEvent(QMouseEvent *event)
 
     QPoint position = event->position().toPoint();
 
-    if (!this->filled_) {
-        this->setCursor(this->tileLayout_->cursorIdle);
-    } else if (this->lock_ == nullptr) {
-        bool leftCondition = (0 <= position.x()) && (position.x() < this->resizeMargin_);
-        bool rightCondition = (this->width() >= position.x()) && (position.x() > this->width() - this->resizeMargin_);
-        bool topCondition = (0 <= position.y()) && (position.y() < this->resizeMargin_);
-        bool bottomCondition = (this->height() >= position.y()) && (position.y() > this->height() - this->resizeMargin_);
-
-        if ((leftCondition || rightCondition) && this->tileLayout_->resizable) {
-            this->setCursor(this->tileLayout_->cursorResizeH);
-        } else if ((topCondition|| bottomCondition) && this->tileLayout_->resizable) {
-            this->setCursor(this->tileLayout_->cursorResizeV);
-        } else if (this->tileLayout_->dragAndDrop && this->rect().contains(position)) {
-            this->setCursor(this->tileLayout_->cursorGrab);
-        } else {
-            this->setCursor(this->tileLayout_->cursorIdle);
+    if (!this->filled_ || !this->isLocked()) {
+        if (!this->tileLayout_->eventDispatch) {
+            this->updateCursor(this->cursorAt(position));
         }
     } else {
         int tileCount = this->getResizeTileCount(position);
         if (tileCount != this->currentTileCount_) {
             this->currentTileCount_ = tileCount;
-            this->tileLayout_->changeTilesColor(this->tileLayout_->colorResize);
-            this->tileLayout_->highlightTiles(this->lock_, this->row_, this->column_, tileCount);
+            this->tileLayout_->highlightTiles(&this->lock_, this->row_, this->column_, tileCount, this->resizeExtent_);
         }
     }
 
@@ -151,35 +160,50 @@ void QTileWidget::mouseMoveEvent(QMouseEvent *event)
 
 void QTileWidget::mousePressEvent(QMouseEvent *event)
 {
+    if (
+        (event->buttons() == Qt::MouseButton::LeftButton) &&
+        (event->modifiers() == Qt::KeyboardModifier::ControlModifier) &&
+        this->filled_ &&
+        this->tileLayout_->selectable
+        ) {
+        this->tileLayout_->setSelected(this->widget_, !this->tileLayout_->isSelected(this->widget_));
+        this->mousePressed_ = false;
+        return Super::mousePressEvent(event);
+    }
+
     if (event->buttons() == Qt::MouseButton::LeftButton) {
-        this->mouseMovePos_ = new QPoint(event->position().toPoint());
-
-        if (
-            (this->mouseMovePos_->x() < this->resizeMargin_) &&
-            this->tileLayout_->resizable
-            ) {
-            this->lock_ = new QPair<int, int>(-1, 0);
-        } else if (
-            (this->mouseMovePos_->x() > this->width() - this->resizeMargin_) &&
-            this->tileLayout_->resizable
-            ) {
-            this->lock_ = new QPair<int, int>(1, 0);
-        } else if (
-            (this->mouseMovePos_->y() < this->resizeMargin_) &&
-            this->tileLayout_->resizable
-            ) {
-            this->lock_ = new QPair<int, int>(0, -1);
-        } else if (
-            (this->mouseMovePos_->y() > this->height() - this->resizeMargin_) &&
-            this->tileLayout_->resizable
-            ) {
-            this->lock_ = new QPair<int, int>(0, 1);
+        this->mouseMovePos_ = event->position().toPoint();
+        this->mousePressed_ = true;
+
+        if (this->filled_) {
+            if (
+                (this->mouseMovePos_.x() < this->resizeMargin_) &&
+                this->tileLayout_->resizable
+                ) {
+                this->lock_ = QPair<int, int>(-1, 0);
+            } else if (
+                (this->mouseMovePos_.x() > this->width() - this->resizeMargin_) &&
+                this->tileLayout_->resizable
+                ) {
+                this->lock_ = QPair<int, int>(1, 0);
+            } else if (
+                (this->mouseMovePos_.y() < this->resizeMargin_) &&
+                this->tileLayout_->resizable
+                ) {
+                this->lock_ = QPair<int, int>(0, -1);
+            } else if (
+                (this->mouseMovePos_.y() > this->height() - this->resizeMargin_) &&
+                this->tileLayout_->resizable
+                ) {
+                this->lock_ = QPair<int, int>(0, 1);
+            }
         }
-        if (this->lock_ != nullptr) {
+        if (this->isLocked()) {
+            this->resizeExtent_ = this->tileLayout_->resizeExtent(&this->lock_, this->row_, this->column_);
             this->tileLayout_->changeTilesColor(this->tileLayout_->colorResize);
         }
     } else {
-        this->mouseMovePos_ = nullptr;
+        this->mousePressed_ = false;
     }
 
     return Super::mousePressEvent(event);
@@ -187,16 +211,17 @@ void QTileWidget::mousePressEvent(QMouseEvent *event)
 
 void QTileWidget::mouseReleaseEvent(QMouseEvent *event)
 {
-    if (this->lock_ == nullptr) {
+    this->mousePressed_ = false;
+    if (!this->isLocked()) {
         return Super::mouseReleaseEvent(event);
     }
 
     int tileCount = this->getResizeTileCount(event->position().toPoint());
 
-    this->tileLayout_->resizeTile(this->lock_, this->row_, this->column_, tileCount);
+    this->tileLayout_->resizeTile(&this->lock_, this->row_, this->column_, tileCount, this->resizeExtent_);
     this->tileLayout_->changeTilesColor(this->tileLayout_->colorIdle);
     this->currentTileCount_ = 0;
-    this->lock_ = nullptr;
+    this->lock_ = QPair<int, int>(0, 0);
 
     return Super::mouseReleaseEvent(event);
 }
@@ -206,7 +231,7 @@ void QTileWidget::dragEnterEvent(QDragEnterEvent *event)
     if (
         this->tileLayout_->dragAndDrop &&
         event->mimeData()->hasFormat(this->MIME_TYPE_TILE_DATA) &&
-        this->isDropPossible(event)
+        this->tileLayout_->isDropPossible(event->mimeData(), this->row_, this->column_)
         ) {
         event->acceptProposedAction();
     }
@@ -214,59 +239,82 @@ void QTileWidget::dragEnterEvent(QDragEnterEvent *event)
 
 void QTileWidget::dropEvent(QDropEvent *event)
 {
-    QJsonDocument dropData = QJsonDocument::fromJson(event->mimeData()->data(this->MIME_TYPE_TILE_DATA));
-    QVariantMap dropDataVariantMap = dropData.toVariant().toMap();
-
-    QUuid id = dropDataVariantMap[this->MIME_KEY_ID].toUuid();
-    int row = dropDataVariantMap[this->MIME_KEY_ROW].toInt();
-    int column = dropDataVariantMap[this->MIME_KEY_COLUMN].toInt();
-    int rowSpan = dropDataVariantMap[this->MIME_KEY_ROW_SPAN].toInt();
-    int columnSpan = dropDataVariantMap[this->MIME_KEY_COLUMN_SPAN].toInt();
-    int rowOffset = dropDataVariantMap[this->MIME_KEY_ROW_OFFSET].toInt();
-    int columnOffset = dropDataVariantMap[this->MIME_KEY_COLUMN_OFFSET].toInt();
-
-    QWidget* widget = this->originTileLayout_->getWidgetToDrop();
-
-    this->tileLayout_->addWidget(
-        widget,
-        this->row_ - rowOffset, this->column_ - columnOffset,
-        rowSpan, columnSpan
-        );
-    emit this->tileLayout_->tileMoved(
-        widget, id, this->tileLayout_->id,
-        row, column,
-        this->row_ - rowOffset, this->column_ - columnOffset
-        );
+    this->tileLayout_->dropWidget(event->mimeData(), this->row_, this->column_);
     event->acceptProposedAction();
 }
 
+bool QTileWidget::eventFilter(QObject *watched, QEvent *event)
+{
+    if ((watched == this->widget_) && (event->type() == QEvent::Resize)) {
+        this->tileLayout_->invalidateDragPixmap(this->widget_);
+    }
+    return Super::eventFilter(watched, event);
+}
+
 void QTileWidget::updateSizeLimit(void)
 {
     this->setFixedSize(
-        this->columnSpan_ * this->horizontalSpan_ + (this->columnSpan_ - 1) * this->tileLayout_->horizontalSpacing(),
-        this->rowSpan_ * this->verticalSpan_ + (this->rowSpan_ - 1) * this->tileLayout_->verticalSpacing()
+        this->tileLayout_->columnAxis().extent(this->column_, this->columnSpan_),
+        this->tileLayout_->rowAxis().extent(this->row_, this->rowSpan_)
         );
 }
 
 void QTileWidget::prepareDropData(QMouseEvent* const event, QDrag &drag)
 {
     QMimeData *dropData = new QMimeData();
-    QVariantMap data = {
-        {this->MIME_KEY_ID, this->tileLayout_->id},
-        {this->MIME_KEY_ROW, this->row_},
-        {this->MIME_KEY_COLUMN, this->column_},
-        {this->MIME_KEY_ROW_SPAN, this->rowSpan_},
-        {this->MIME_KEY_COLUMN_SPAN, this->columnSpan_},
-        {this->MIME_KEY_ROW_OFFSET, event->position().toPoint().y() / (this->verticalSpan_ + this->tileLayout_->verticalSpacing())},
-        {this->MIME_KEY_COLUMN_OFFSET, event->position().toPoint().x() / (this->horizontalSpan_ + this->tileLayout_->horizontalSpacing())}
-    };
-    QJsonDocument dataToText = QJsonDocument::fromVariant(data);
-    dropData->setData(this->MIME_TYPE_TILE_DATA, QByteArray(dataToText.toJson()));
-    QPixmap dragIcon = this->widget_->grab();
-
-    drag.setPixmap(dragIcon);
+    QTileDropData data;
+    data.id = this->tileLayout_->id;
+    data.row = this->row_;
+    data.column = this->column_;
+    data.rowSpan = this->rowSpan_;
+    data.columnSpan = this->columnSpan_;
+    const QTileAxis &rowAxis = this->tileLayout_->rowAxis();
+    const QTileAxis &columnAxis = this->tileLayout_->columnAxis();
+    int row = rowAxis.indexAt(rowAxis.offset(this->row_) + qMax(event->position().toPoint().y(), 0));
+    int column = columnAxis.indexAt(columnAxis.offset(this->column_) + qMax(event->position().toPoint().x(), 0));
+    data.rowOffset = qBound(0, row - this->row_, this->rowSpan_ - 1);
+    data.columnOffset = qBound(0, column - this->column_, this->columnSpan_ - 1);
+    dropData->setData(this->MIME_TYPE_TILE_DATA, data.encode());
+    drag.setPixmap(this->dragPixmap());
     drag.setMimeData(dropData);
-    drag.setHotSpot(event->position().toPoint() - this->rect().topLeft());
+    drag.setHotSpot((event->position().toPoint() - this->rect().topLeft()) * this->dragPixmapScale_);
+}
+
+QPixmap QTileWidget::dragPixmap(void)
+{
+    QSize size = this->widget_->size();
+    QSize maximumSize = this->tileLayout_->dragPixmapMaximumSize;
+    QSize scaledSize = size;
+    if (maximumSize.isValid() && ((size.width() > maximumSize.width()) || (size.height() > maximumSize.height()))) {
+        scaledSize = size.scaled(maximumSize, Qt::AspectRatioMode::KeepAspectRatio);
+    }
+    this->dragPixmapScale_ = (size.width() > 0)? qreal(scaledSize.width()) / size.width() : 1;
+    if (this->tileLayout_->dragPixmaps_.contains(this->widget_)) {
+        return this->tileLayout_->dragPixmaps_.value(this->widget_);
+    }
+
+    QPixmap pixmap;
+
+    int outlineThreshold = this->tileLayout_->dragOutlineThreshold;
+    if ((outlineThreshold > 0) && (size.width() * size.height() > outlineThreshold)) {
+        pixmap = QPixmap(scaledSize);
+        pixmap.fill(Qt::GlobalColor::transparent);
+        QPainter painter(&pixmap);
+        painter.setPen(this->tileLayout_->colorEmptyCheck);
+        painter.drawRect(pixmap.rect().adjusted(0, 0, -1, -1));
+    } else {
+        qreal ratio = (scaledSize == size)? this->devicePixelRatioF() : 1;
+        pixmap = QPixmap(scaledSize * ratio);
+        pixmap.setDevicePixelRatio(ratio);
+        pixmap.fill(Qt::GlobalColor::transparent);
+        QPainter painter(&pixmap);
+        painter.scale(this->dragPixmapScale_, this->dragPixmapScale_);
+        this->widget_->render(&painter);
+    }
+    if (this->tileLayout_->dragPixmapCache) {
+        this->tileLayout_->dragPixmaps_.insert(this->widget_, pixmap);
+    }
+    return pixmap;
 }
 
 void QTileWidget::dragAndDropProcess(QDrag &drag)
@@ -288,7 +336,10 @@ void QTileWidget::dragAndDropProcess(QDrag &drag)
         }
     }
 
-    if (drag.exec() != Qt::DropAction::MoveAction) {
+    Qt::DropAction dropAction = drag.exec();
+    QTileDropData::clearCache();
+
+    if (dropAction != Qt::DropAction::MoveAction) {
         this->removeWidget();
         QWidget *widget = this->tileLayout_->getWidgetToDrop();
         this->tileLayout_->addWidget(widget, this->row_, this->column_, prevRowSpan, prevColumnSpan);
@@ -297,87 +348,45 @@ void QTileWidget::dragAndDropProcess(QDrag &drag)
         }
     }
 
-    this->originTileLayout_ = this->tileLayout_;
     this->setVisible(true);
     this->dragInProcess_ = false;
 }
 
 void QTileWidget::removeWidget(void)
 {
+    if (this->widget_ != nullptr) {
+        this->widget_->removeEventFilter(this);
+    }
     this->layout()->removeWidget(this->widget_);
     this->widget_ = nullptr;
     this->filled_ = false;
 }
 
-int QTileWidget::getResizeTileCount(const QPoint &position)
+bool QTileWidget::isLocked(void)
 {
-    return this->getResizeTileCount(position.x(), position.y());
+    return (this->lock_.first != 0) || (this->lock_.second != 0);
 }
 
-int QTileWidget::getResizeTileCount(const int x, const int y)
+void QTileWidget::updateCursor(const Qt::CursorShape cursor)
 {
-    int swX = (this->lock_->first != 0)? 1 : 0;
-    int swY = (this->lock_->second != 0)? 1 : 0;
-    int swP = (this->lock_->first + this->lock_->second == 1)? 1 : 0;
-    int span = this->horizontalSpan_ * swX + this->verticalSpan_ * swY;
-    int tileSpan = this->columnSpan_ * swX + this->rowSpan_ * swY;
-    int spacing = this->tileLayout_->verticalSpacing() * swX + this->tileLayout_->horizontalSpacing() * swY;
-
-    assert(span + spacing != 0);
-    int tileCount = (x * swX + y * swY + span / 2 - span * tileSpan * swP);
-    int swN = (tileCount < 0)? 1 : 0;
-    tileCount /= (span + spacing);
-    return tileCount - swN;
+    if (this->cursor().shape() != cursor) {
+        this->setCursor(cursor);
+    }
 }
 
-bool QTileWidget::isDropPossible(QDragEnterEvent *event)
+int QTileWidget::getResizeTileCount(const QPoint &position)
 {
-    QJsonParseError *jsonError = new QJsonParseError();
-    QJsonDocument dropData = QJsonDocument::fromJson(event->mimeData()->data(this->MIME_TYPE_TILE_DATA), jsonError);
-
-    if (jsonError->error != QJsonParseError::NoError) return false;
-
-    QVariant dropDataVariant = dropData.toVariant();
-
-    if (!dropDataVariant.canConvert<QVariantMap>()) return false;
-
-    QVariantMap dropDataVariantMap = dropDataVariant.toMap();
-
-    if (!this->canConvert<QUuid>(dropDataVariantMap, this->MIME_KEY_ID)) return false;
-    if (!this->canConvert<int>(dropDataVariantMap, this->MIME_KEY_ROW)) return false;
-    if (!this->canConvert<int>(dropDataVariantMap, this->MIME_KEY_COLUMN)) return false;
-    if (!this->canConvert<int>(dropDataVariantMap, this->MIME_KEY_ROW_SPAN)) return false;
-    if (!this->canConvert<int>(dropDataVariantMap, this->MIME_KEY_COLUMN_SPAN)) return false;
-    if (!this->canConvert<int>(dropDataVariantMap, this->MIME_KEY_ROW_OFFSET)) return false;
-    if (!this->canConvert<int>(dropDataVariantMap, this->MIME_KEY_COLUMN_OFFSET)) return false;
-
-    QUuid id = dropDataVariantMap[this->MIME_KEY_ID].toUuid();
-
-    if (!this->tileLayout_->linkedLayouts.contains(id)) return false;
-
-    this->originTileLayout_ = this->tileLayout_->linkedLayouts[id];
-
-    QMapIterator<QUuid, QTileLayout*> itr(this->originTileLayout_->linkedLayouts);
-    while (itr.hasNext()) {
-        auto item = itr.next();
-        if (item.value()->dragAndDrop) {
-            item.value()->changeTilesColor(this->tileLayout_->colorDragAndDrop);
-        }
-    }
-
-    return this->tileLayout_->isAreaEmpty(
-        this->row_ - dropDataVariantMap[this->MIME_KEY_ROW_OFFSET].toInt(),
-        this->column_ - dropDataVariantMap[this->MIME_KEY_COLUMN_OFFSET].toInt(),
-        dropDataVariantMap[this->MIME_KEY_ROW_SPAN].toInt(),
-        dropDataVariantMap[this->MIME_KEY_COLUMN_SPAN].toInt(),
-        this->tileLayout_->colorDragAndDrop
-        );
+    return this->getResizeTileCount(position.x(), position.y());
 }
 
-template <typename T>
-bool QTileWidget::canConvert(const QVariantMap &map, const QString &key)
+int QTileWidget::getResizeTileCount(const int x, const int y)
 {
-    if (!map.contains(key)) return false;
-    if (!map[key].canConvert<T>()) return false;
-    return true;
+    bool horizontal = (this->lock_.first != 0);
+    bool positive = (this->lock_.first + this->lock_.second == 1);
+    const QTileAxis &axis = horizontal? this->tileLayout_->columnAxis() : this->tileLayout_->rowAxis();
+    int index = horizontal? this->column_ : this->row_;
+    int tileSpan = horizontal? this->columnSpan_ : this->rowSpan_;
+
+    int boundary = axis.boundaryAt(axis.offset(index) + (horizontal? x : y));
+    return boundary - (positive? index + tileSpan : index);
 }
@@ -28,16 +28,19 @@ TestWindow::TestWindow(QWidget *parent)
     this->tileLayout->setColorDragAndDrop(QColor(211, 211, 211));
     this->tileLayout->setColorEmptyCheck(QColor(150, 150, 150));
 
+    this->tileLayout->beginUpdate();
+    QList<QPair<QWidget*, QRect>> placements;
     for (int r = 0; r < rows - 2; r++) {
         for (int c = 0; c < columns; c++) {
             QLabel *label = new QLabel(this);
             this->spawnRandomLabel(*label);
-            this->tileLayout->addWidget(label, r, c);
+            placements.append({label, QRect(c, r, 1, 1)});
         }
     }
     QLabel *label = new QLabel(this);
     this->spawnRandomLabel(*label);
-    this->tileLayout->addWidget(label, rows - 2, 1, 2, 2);
+    placements.append({label, QRect(1, rows - 2, 2, 2)});
+    this->tileLayout->addWidgets(placements);
 
     label = new QLabel(this);
     this->spawnRandomLabel(*label);
@@ -57,6 +60,7 @@ TestWindow::TestWindow(QWidget *parent)
     this->tileLayout->addColumns(1);
     this->tileLayout->removeRows(1);
     this->tileLayout->removeColumns(1);
+    this->tileLayout->endUpdate();
 
     QWidget *central_widget = new QWidget();
     central_widget->setContentsMargins(0, 0, 0, 0);
@@ -0,0 +1,452 @@
+#include "tst_qtilegrid.h"
+
+/*
+ * Unit tests of QTileGrid and of the occupancy index behind it.
+ * The area queries are compared with a brute-force reference on random grids. The grids are up to 200 columns
+ * wide, so that rows span several bitset words, and queries are mixed with changes, so that both the word scan
+ * and the prefix sums answer them. Moves, group moves and compaction are checked the same way against a plain map
+ * of areas, including the state left behind by a rejected group move. A fixed seed keeps failures reproducible.
+ */
+
+QTileGrid TestQTileGrid::randomGrid(QRandomGenerator &random, QList<QList<bool>> &cells)
+{
+    int rows = random.bounded(1, 91);
+    int columns = random.bounded(1, 201);
+    QTileGrid grid(rows, columns);
+    cells = QList<QList<bool>>(rows, QList<bool>(columns, false));
+
+    QList<QTileGrid::Key> keys;
+    int attempts = random.bounded(rows * columns / 4 + 1);
+    for (int index = 0; index < attempts; index++) {
+        QRect area;
+        if (random.bounded(16) == 0) {
+            area = QRect(0, random.bounded(rows), columns, 1);
+        } else {
+            int rowSpan = random.bounded(1, qMin(rows, 8) + 1);
+            int columnSpan = random.bounded(1, qMin(columns, 12) + 1);
+            area = QRect(random.bounded(columns - columnSpan + 1), random.bounded(rows - rowSpan + 1), columnSpan, rowSpan);
+        }
+        QTileGrid::Key key = index + 1;
+        if (grid.place(key, area)) {
+            keys.append(key);
+            for (int row = area.top(); row <= area.bottom(); row++) {
+                for (int column = area.left(); column <= area.right(); column++) {
+                    cells[row][column] = true;
+                }
+            }
+        }
+    }
+
+    for (QTileGrid::Key key : keys) {
+        if (random.bounded(4) == 0) {
+            QRect area = grid.area(key);
+            grid.remove(key);
+            for (int row = area.top(); row <= area.bottom(); row++) {
+                for (int column = area.left(); column <= area.right(); column++) {
+                    cells[row][column] = false;
+                }
+            }
+        }
+    }
+    return grid;
+}
+
+void TestQTileGrid::randomSpans(QRandomGenerator &random, const QTileGrid &grid, int &rowSpan, int &columnSpan)
+{
+    rowSpan = random.bounded(1, qMin(grid.rowCount(), 6) + 1);
+    columnSpan = (random.bounded(8) == 0) ? grid.columnCount() : random.bounded(1, qMin(grid.columnCount(), 16) + 1);
+}
+
+bool TestQTileGrid::referenceAreaEmpty(const QList<QList<bool>> &cells, const QRect &area)
+{
+    for (int row = area.top(); row <= area.bottom(); row++) {
+        for (int column = area.left(); column <= area.right(); column++) {
+            if (cells[row][column]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool TestQTileGrid::referenceFreeArea(const QList<QList<bool>> &cells, const int rowSpan, const int columnSpan, int &row, int &column, const bool bestFit)
+{
+    int rows = cells.size();
+    int columns = cells.first().size();
+    int bestWaste = -1;
+    for (int r = 0; r + rowSpan <= rows; r++) {
+        int c = 0;
+        while (c < columns) {
+            if (!referenceAreaEmpty(cells, QRect(c, r, 1, rowSpan))) {
+                c++;
+                continue;
+            }
+            int end = c;
+            while ((end < columns) && referenceAreaEmpty(cells, QRect(end, r, 1, rowSpan))) {
+                end++;
+            }
+            int waste = end - c - columnSpan;
+            if ((waste >= 0) && ((bestWaste < 0) || (waste < bestWaste))) {
+                row = r;
+                column = c;
+                bestWaste = waste;
+                if (!bestFit || (waste == 0)) {
+                    return true;
+                }
+            }
+            c = end;
+        }
+    }
+    return bestWaste >= 0;
+}
+
+bool TestQTileGrid::referenceMove(QHash<QTileGrid::Key, QRect> &areas, const int rows, const int columns, const QHash<QTileGrid::Key, QRect> &moves)
+{
+    QHash<QTileGrid::Key, QRect> moved = areas;
+    for (auto itr = moves.constBegin(); itr != moves.constEnd(); ++itr) {
+        if (!areas.contains(itr.key()) || !itr.value().isValid() || !QRect(0, 0, columns, rows).contains(itr.value())) {
+            return false;
+        }
+        moved[itr.key()] = itr.value();
+    }
+    for (auto itr = moves.constBegin(); itr != moves.constEnd(); ++itr) {
+        for (auto other = moved.constBegin(); other != moved.constEnd(); ++other) {
+            if ((other.key() != itr.key()) && other.value().intersects(itr.value())) {
+                return false;
+            }
+        }
+    }
+    areas = moved;
+    return true;
+}
+
+QList<QList<bool>> TestQTileGrid::referenceCells(const QHash<QTileGrid::Key, QRect> &areas, const int rows, const int columns)
+{
+    QList<QList<bool>> cells(rows, QList<bool>(columns, false));
+    for (auto itr = areas.constBegin(); itr != areas.constEnd(); ++itr) {
+        for (int row = itr.value().top(); row <= itr.value().bottom(); row++) {
+            for (int column = itr.value().left(); column <= itr.value().right(); column++) {
+                cells[row][column] = true;
+            }
+        }
+    }
+    return cells;
+}
+
+bool TestQTileGrid::isConsistent(const QTileGrid &grid, const QHash<QTileGrid::Key, QRect> &areas)
+{
+    int rows = grid.rowCount();
+    int columns = grid.columnCount();
+    if (grid.size() != areas.size()) {
+        return false;
+    }
+
+    QList<QTileGrid::Key> cellKeys(rows * columns, 0);
+    for (auto itr = areas.constBegin(); itr != areas.constEnd(); ++itr) {
+        if (!grid.contains(itr.key()) || (grid.area(itr.key()) != itr.value())) {
+            return false;
+        }
+        for (int row = itr.value().top(); row <= itr.value().bottom(); row++) {
+            for (int column = itr.value().left(); column <= itr.value().right(); column++) {
+                cellKeys[row * columns + column] = itr.key();
+            }
+        }
+    }
+    for (int row = 0; row < rows; row++) {
+        for (int column = 0; column < columns; column++) {
+            QTileGrid::Key key = cellKeys[row * columns + column];
+            if ((grid.keyAt(row, column) != key) || (grid.isFilled(row, column) != (key != 0))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+QRect TestQTileGrid::randomArea(QRandomGenerator &random, const QTileGrid &grid)
+{
+    int rowSpan = random.bounded(1, qMin(grid.rowCount(), 5) + 1);
+    int columnSpan = random.bounded(1, qMin(grid.columnCount(), 8) + 1);
+    return QRect(
+        random.bounded(-1, grid.columnCount() - columnSpan + 2),
+        random.bounded(-1, grid.rowCount() - rowSpan + 2),
+        columnSpan, rowSpan
+        );
+}
+
+void TestQTileGrid::isAreaEmpty(void)
+{
+    QRandomGenerator random(1);
+    for (int index = 0; index < this->GRID_COUNT; index++) {
+        QList<QList<bool>> cells;
+        QTileGrid grid = this->randomGrid(random, cells);
+        int rows = grid.rowCount();
+        int columns = grid.columnCount();
+
+        for (int query = 0; query < this->QUERY_COUNT; query++) {
+            int rowSpan = random.bounded(1, rows + 1);
+            int columnSpan = random.bounded(1, columns + 1);
+            QRect area(random.bounded(columns - columnSpan + 1), random.bounded(rows - rowSpan + 1), columnSpan, rowSpan);
+            QCOMPARE(grid.isAreaEmpty(area.y(), area.x(), area.height(), area.width()), referenceAreaEmpty(cells, area));
+
+            if (random.bounded(3) == 0) {
+                int row = random.bounded(rows);
+                int column = random.bounded(columns);
+                if (grid.place(QTileGrid::Key(1000000 + query), QRect(column, row, 1, 1))) {
+                    cells[row][column] = true;
+                }
+            }
+        }
+
+        QVERIFY(!grid.isAreaEmpty(-1, 0, 1, 1));
+        QVERIFY(!grid.isAreaEmpty(0, 0, rows + 1, 1));
+        QVERIFY(!grid.isAreaEmpty(0, columns - 1, 1, 2));
+        QVERIFY(!grid.isAreaEmpty(0, 0, 0, 1));
+    }
+}
+
+void TestQTileGrid::compareFreeArea(const bool bestFit)
+{
+    QRandomGenerator random(bestFit ? 3 : 2);
+    for (int index = 0; index < this->GRID_COUNT; index++) {
+        QList<QList<bool>> cells;
+        QTileGrid grid = this->randomGrid(random, cells);
+
+        for (int query = 0; query < this->QUERY_COUNT; query++) {
+            int rowSpan, columnSpan;
+            this->randomSpans(random, grid, rowSpan, columnSpan);
+            int row = -1, column = -1;
+            int expectedRow = -1, expectedColumn = -1;
+            bool expected = referenceFreeArea(cells, rowSpan, columnSpan, expectedRow, expectedColumn, bestFit);
+            QCOMPARE(grid.findFreeArea(rowSpan, columnSpan, row, column, bestFit), expected);
+            if (expected) {
+                QCOMPARE(row, expectedRow);
+                QCOMPARE(column, expectedColumn);
+            }
+        }
+    }
+}
+
+void TestQTileGrid::findFreeArea(void)
+{
+    this->compareFreeArea(false);
+
+    QTileGrid grid(3, 70);
+    grid.place(1, QRect(0, 0, 70, 1));
+    grid.place(2, QRect(0, 1, 65, 2));
+    int row = -1, column = -1;
+    QVERIFY(grid.findFreeArea(2, 5, row, column, false));
+    QCOMPARE(row, 1);
+    QCOMPARE(column, 65);
+    QVERIFY(!grid.findFreeArea(2, 6, row, column, false));
+    QVERIFY(!grid.findFreeArea(3, 1, row, column, false));
+}
+
+void TestQTileGrid::findBestFreeArea(void)
+{
+    this->compareFreeArea(true);
+
+    QTileGrid grid(2, 10);
+    grid.place(1, QRect(3, 0, 1, 2));
+    grid.place(2, QRect(6, 0, 1, 2));
+    int row = -1, column = -1;
+    QVERIFY(grid.findFreeArea(2, 2, row, column, true));
+    QCOMPARE(row, 0);
+    QCOMPARE(column, 4);
+    QVERIFY(grid.findFreeArea(2, 3, row, column, true));
+    QCOMPARE(row, 0);
+    QCOMPARE(column, 0);
+}
+
+void TestQTileGrid::placeAndMove(void)
+{
+    QTileGrid grid(4, 6);
+    QVERIFY(grid.place(1, QRect(0, 0, 2, 2)));
+    QVERIFY(!grid.place(2, QRect(1, 1, 2, 2)));
+    QVERIFY(!grid.place(1, QRect(4, 0, 1, 1)));
+    QVERIFY(!grid.place(3, QRect(5, 3, 2, 1)));
+    QVERIFY(grid.place(2, QRect(3, 0, 1, 1)));
+    QCOMPARE(grid.keyAt(1, 1), QTileGrid::Key(1));
+    QCOMPARE(grid.size(), 2);
+
+    QVERIFY(grid.isAreaFree(1, QRect(1, 0, 2, 2)));
+    QVERIFY(!grid.isAreaFree(1, QRect(2, 0, 2, 2)));
+    QVERIFY(!grid.isAreaFree(3, QRect(0, 0, 1, 1)));
+    QVERIFY(grid.move(1, QRect(1, 0, 2, 2)));
+    QCOMPARE(grid.area(1), QRect(1, 0, 2, 2));
+    QCOMPARE(grid.keyAt(0, 0), QTileGrid::Key(0));
+    QCOMPARE(grid.keyAt(1, 2), QTileGrid::Key(1));
+    QVERIFY(!grid.isFilled(1, 0));
+
+    QVERIFY(!grid.move(1, QRect(2, 0, 2, 2)));
+    QVERIFY(!grid.move(1, QRect(5, 3, 2, 2)));
+    QVERIFY(!grid.move(3, QRect(0, 3, 1, 1)));
+    QVERIFY(isConsistent(grid, {{1, QRect(1, 0, 2, 2)}, {2, QRect(3, 0, 1, 1)}}));
+
+    grid.remove(1);
+    QVERIFY(!grid.contains(1));
+    QVERIFY(grid.isAreaEmpty(0, 0, 4, 3));
+    QVERIFY(isConsistent(grid, {{2, QRect(3, 0, 1, 1)}}));
+}
+
+void TestQTileGrid::moveGroup(void)
+{
+    QTileGrid grid(2, 5);
+    grid.place(1, QRect(0, 0, 2, 2));
+    grid.place(2, QRect(2, 0, 2, 2));
+
+    QVERIFY(!grid.move(1, QRect(2, 0, 2, 2)));
+    QVERIFY(grid.move(QHash<QTileGrid::Key, QRect>({{1, QRect(2, 0, 2, 2)}, {2, QRect(0, 0, 2, 2)}})));
+    QVERIFY(isConsistent(grid, {{1, QRect(2, 0, 2, 2)}, {2, QRect(0, 0, 2, 2)}}));
+
+    QVERIFY(grid.move(QHash<QTileGrid::Key, QRect>({{1, QRect(3, 0, 2, 2)}, {2, QRect(1, 0, 2, 2)}})));
+    QVERIFY(isConsistent(grid, {{1, QRect(3, 0, 2, 2)}, {2, QRect(1, 0, 2, 2)}}));
+    QVERIFY(grid.move(QHash<QTileGrid::Key, QRect>()));
+}
+
+void TestQTileGrid::moveGroupRollback(void)
+{
+    QTileGrid grid(3, 6);
+    grid.place(1, QRect(0, 0, 2, 1));
+    grid.place(2, QRect(2, 0, 2, 1));
+    grid.place(3, QRect(0, 1, 2, 1));
+    const QHash<QTileGrid::Key, QRect> areas = {{1, QRect(0, 0, 2, 1)}, {2, QRect(2, 0, 2, 1)}, {3, QRect(0, 1, 2, 1)}};
+
+    QVERIFY(!grid.move(QHash<QTileGrid::Key, QRect>({{1, QRect(0, 2, 2, 1)}, {2, QRect(0, 1, 2, 1)}})));
+    QVERIFY(isConsistent(grid, areas));
+    QVERIFY(!grid.move(QHash<QTileGrid::Key, QRect>({{1, QRect(4, 0, 2, 1)}, {2, QRect(4, 0, 2, 1)}})));
+    QVERIFY(isConsistent(grid, areas));
+    QVERIFY(!grid.move(QHash<QTileGrid::Key, QRect>({{1, QRect(4, 2, 2, 1)}, {2, QRect(5, 2, 2, 1)}})));
+    QVERIFY(isConsistent(grid, areas));
+    QVERIFY(!grid.move(QHash<QTileGrid::Key, QRect>({{1, QRect(4, 2, 2, 1)}, {4, QRect(4, 1, 1, 1)}})));
+    QVERIFY(isConsistent(grid, areas));
+
+    int row = -1, column = -1;
+    QVERIFY(grid.findFreeArea(3, 2, row, column, false));
+    QCOMPARE(row, 0);
+    QCOMPARE(column, 4);
+}
+
+void TestQTileGrid::compact(void)
+{
+    QTileGrid grid(4, 4);
+    grid.place(1, QRect(0, 1, 1, 1));
+    grid.place(2, QRect(1, 2, 2, 1));
+    grid.place(3, QRect(0, 3, 3, 1));
+    QVERIFY(grid.compact(QTileGrid::CompactUp));
+    QVERIFY(isConsistent(grid, {{1, QRect(0, 0, 1, 1)}, {2, QRect(1, 0, 2, 1)}, {3, QRect(0, 1, 3, 1)}}));
+    QVERIFY(!grid.compact(QTileGrid::CompactUp));
+
+    grid = QTileGrid(3, 4);
+    grid.place(1, QRect(2, 0, 1, 1));
+    grid.place(2, QRect(3, 1, 1, 2));
+    grid.place(3, QRect(1, 2, 1, 1));
+    QVERIFY(grid.compact(QTileGrid::CompactLeft));
+    QVERIFY(isConsistent(grid, {{1, QRect(0, 0, 1, 1)}, {2, QRect(1, 1, 1, 2)}, {3, QRect(0, 2, 1, 1)}}));
+    QVERIFY(!grid.compact(QTileGrid::CompactLeft));
+}
+
+void TestQTileGrid::changedAreas(void)
+{
+    QTileGrid grid(3, 3);
+    grid.place(1, QRect(0, 0, 1, 1));
+    grid.place(2, QRect(1, 0, 1, 1));
+    grid.place(3, QRect(2, 0, 1, 1));
+
+    QTileGrid rearranged = grid;
+    rearranged.move(1, QRect(0, 2, 1, 1));
+    rearranged.remove(2);
+    const QHash<QTileGrid::Key, QRect> changes = {{1, QRect(0, 2, 1, 1)}, {2, QRect()}};
+    QCOMPARE(rearranged.changedAreas(grid), changes);
+    QVERIFY(grid.changedAreas(grid).isEmpty());
+    QVERIFY(isConsistent(grid, {{1, QRect(0, 0, 1, 1)}, {2, QRect(1, 0, 1, 1)}, {3, QRect(2, 0, 1, 1)}}));
+}
+
+void TestQTileGrid::randomOperations(void)
+{
+    QRandomGenerator random(4);
+    for (int index = 0; index < this->GRID_COUNT; index++) {
+        QTileGrid grid(random.bounded(1, 31), random.bounded(1, 141));
+        int rows = grid.rowCount();
+        int columns = grid.columnCount();
+        QHash<QTileGrid::Key, QRect> areas;
+        QTileGrid::Key nextKey = 1;
+
+        for (int operation = 0; operation < this->OPERATION_COUNT; operation++) {
+            QList<QTileGrid::Key> keys = areas.keys();
+            int kind = keys.isEmpty() ? 0 : random.bounded(10);
+            if (kind < 4) {
+                QRect area = this->randomArea(random, grid);
+                QHash<QTileGrid::Key, QRect> placed = areas;
+                placed.insert(nextKey, QRect(-1, -1, 1, 1));
+                bool expected = referenceMove(placed, rows, columns, {{nextKey, area}});
+                QCOMPARE(grid.place(nextKey, area), expected);
+                if (expected) {
+                    areas = placed;
+                }
+                nextKey++;
+            } else if (kind == 4) {
+                QTileGrid::Key key = keys[random.bounded(keys.size())];
+                grid.remove(key);
+                areas.remove(key);
+            } else if (kind < 7) {
+                QTileGrid::Key key = keys[random.bounded(keys.size())];
+                QRect area = areas[key];
+                QRect target(area.x() + random.bounded(-2, 3), area.y() + random.bounded(-2, 3), area.width() + random.bounded(-1, 2), area.height() + random.bounded(-1, 2));
+                bool expected = referenceMove(areas, rows, columns, {{key, target}});
+                QCOMPARE(grid.move(key, target), expected);
+            } else if (kind < 9) {
+                QHash<QTileGrid::Key, QRect> moves;
+                int rowOffset = random.bounded(-1, 2);
+                int columnOffset = random.bounded(-2, 3);
+                for (int count = random.bounded(1, 5); count > 0; count--) {
+                    QTileGrid::Key key = keys[random.bounded(keys.size())];
+                    moves.insert(key, (random.bounded(4) == 0) ? this->randomArea(random, grid) : QRect(
+                        areas[key].x() + columnOffset, areas[key].y() + rowOffset, areas[key].width(), areas[key].height()
+                        ));
+                }
+                if (random.bounded(20) == 0) {
+                    moves.insert(nextKey, QRect(0, 0, 1, 1));
+                }
+                bool expected = referenceMove(areas, rows, columns, moves);
+                QCOMPARE(grid.move(moves), expected);
+            } else {
+                QTileGrid::CompactionMode mode = (random.bounded(2) == 0) ? QTileGrid::CompactUp : QTileGrid::CompactLeft;
+                grid.compact(mode);
+                for (auto itr = areas.constBegin(); itr != areas.constEnd(); ++itr) {
+                    QRect area = grid.area(itr.key());
+                    QCOMPARE(area.size(), itr.value().size());
+                    if (mode == QTileGrid::CompactUp) {
+                        QCOMPARE(area.x(), itr.value().x());
+                        QVERIFY(area.y() <= itr.value().y());
+                    } else {
+                        QCOMPARE(area.y(), itr.value().y());
+                        QVERIFY(area.x() <= itr.value().x());
+                    }
+                }
+                QHash<QTileGrid::Key, QRect> compacted;
+                for (QTileGrid::Key key : keys) {
+                    compacted.insert(key, QRect(-1, -1, 1, 1));
+                }
+                for (QTileGrid::Key key : keys) {
+                    QVERIFY(referenceMove(compacted, rows, columns, {{key, grid.area(key)}}));
+                }
+                areas = compacted;
+            }
+            QVERIFY(isConsistent(grid, areas));
+
+            int rowSpan, columnSpan;
+            this->randomSpans(random, grid, rowSpan, columnSpan);
+            int row = -1, column = -1;
+            int expectedRow = -1, expectedColumn = -1;
+            bool expected = referenceFreeArea(referenceCells(areas, rows, columns), rowSpan, columnSpan, expectedRow, expectedColumn, false);
+            QCOMPARE(grid.findFreeArea(rowSpan, columnSpan, row, column, false), expected);
+            if (expected) {
+                QCOMPARE(row, expectedRow);
+                QCOMPARE(column, expectedColumn);
+            }
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(TestQTileGrid)
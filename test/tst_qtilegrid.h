@@ -0,0 +1,40 @@
+#ifndef TST_QTILEGRID_H
+#define TST_QTILEGRID_H
+
+#include <QtTest/QTest>
+#include <QtCore/QRandomGenerator>
+#include "QTileLayout/qtilegrid.h"
+
+class TestQTileGrid : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void isAreaEmpty(void);
+    void findFreeArea(void);
+    void findBestFreeArea(void);
+    void placeAndMove(void);
+    void moveGroup(void);
+    void moveGroupRollback(void);
+    void compact(void);
+    void changedAreas(void);
+    void randomOperations(void);
+
+protected:
+    QTileGrid randomGrid(QRandomGenerator &random, QList<QList<bool>> &cells);
+    void randomSpans(QRandomGenerator &random, const QTileGrid &grid, int &rowSpan, int &columnSpan);
+    static bool referenceAreaEmpty(const QList<QList<bool>> &cells, const QRect &area);
+    static bool referenceFreeArea(const QList<QList<bool>> &cells, const int rowSpan, const int columnSpan, int &row, int &column, const bool bestFit);
+    void compareFreeArea(const bool bestFit);
+    static bool referenceMove(QHash<QTileGrid::Key, QRect> &areas, const int rows, const int columns, const QHash<QTileGrid::Key, QRect> &moves);
+    static QList<QList<bool>> referenceCells(const QHash<QTileGrid::Key, QRect> &areas, const int rows, const int columns);
+    static bool isConsistent(const QTileGrid &grid, const QHash<QTileGrid::Key, QRect> &areas);
+    QRect randomArea(QRandomGenerator &random, const QTileGrid &grid);
+
+    static const int GRID_COUNT = 60;
+    static const int QUERY_COUNT = 30;
+    static const int OPERATION_COUNT = 400;
+
+private:
+};
+#endif // TST_QTILEGRID_H
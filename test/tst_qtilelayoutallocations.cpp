@@ -0,0 +1,130 @@
+#include "tst_qtilelayoutallocations.h"
+#include "QTileLayout/qtilewidget.h"
+#include "QTileLayout/qtiledropdata.h"
+#include <atomic>
+#include <cstdlib>
+
+#if defined(__GLIBC__)
+extern "C" void* __libc_malloc(std::size_t size);
+extern "C" void* __libc_calloc(std::size_t count, std::size_t size);
+extern "C" void* __libc_realloc(void *pointer, std::size_t size);
+
+static std::atomic<long> allocationCount(0);
+static thread_local bool countAllocations = false;
+
+extern "C" void* malloc(std::size_t size)
+{
+    if (countAllocations) {
+        allocationCount++;
+    }
+    return __libc_malloc(size);
+}
+
+extern "C" void* calloc(std::size_t count, std::size_t size)
+{
+    if (countAllocations) {
+        allocationCount++;
+    }
+    return __libc_calloc(count, size);
+}
+
+extern "C" void* realloc(void *pointer, std::size_t size)
+{
+    if (countAllocations) {
+        allocationCount++;
+    }
+    return __libc_realloc(pointer, size);
+}
+#endif
+
+/*
+ * Check that the steady-state interaction path makes no heap allocation.
+ * The window is shown and a tile is resized back and forth by its left edge, so every cycle runs a real hover,
+ * press, resize preview and committed resize, then a drag enters the layout. The malloc family is interposed
+ * above, which also covers operator new and the Qt container storage; it needs glibc. Only the test thread is
+ * counted, and the first pass is a warm-up.
+ */
+
+long TestQTileLayoutAllocations::resizeLeftEdge(QWidget* const widget, const int x)
+{
+#if defined(__GLIBC__)
+    QWidget *tile = widget->parentWidget();
+    QMouseEvent hover(QEvent::MouseMove, QPointF(1, 8), tile->mapToGlobal(QPointF(1, 8)), Qt::MouseButton::NoButton, Qt::MouseButton::NoButton, Qt::KeyboardModifier::NoModifier);
+    QMouseEvent press(QEvent::MouseButtonPress, QPointF(1, 8), tile->mapToGlobal(QPointF(1, 8)), Qt::MouseButton::LeftButton, Qt::MouseButton::LeftButton, Qt::KeyboardModifier::NoModifier);
+    QMouseEvent move(QEvent::MouseMove, QPointF(x, 8), tile->mapToGlobal(QPointF(x, 8)), Qt::MouseButton::NoButton, Qt::MouseButton::LeftButton, Qt::KeyboardModifier::NoModifier);
+    QMouseEvent release(QEvent::MouseButtonRelease, QPointF(x, 8), tile->mapToGlobal(QPointF(x, 8)), Qt::MouseButton::LeftButton, Qt::MouseButton::NoButton, Qt::KeyboardModifier::NoModifier);
+
+    long allocations = allocationCount;
+    countAllocations = true;
+    tile->event(&hover);
+    tile->event(&press);
+    tile->event(&move);
+    countAllocations = false;
+    allocations = allocationCount - allocations;
+
+    // committing the resize moves the widget between QGridLayout items, which Qt allocates
+    tile->event(&release);
+    return allocations;
+#else
+    return 0;
+#endif
+}
+
+long TestQTileLayoutAllocations::enterDrag(QTileLayout* const layout, const QMimeData &mimeData)
+{
+#if defined(__GLIBC__)
+    long allocations = allocationCount;
+    countAllocations = true;
+    layout->isDropPossible(&mimeData, 0, 0);
+    layout->changeTilesColor(layout->colorIdle);
+    countAllocations = false;
+    return allocationCount - allocations;
+#else
+    return 0;
+#endif
+}
+
+void TestQTileLayoutAllocations::interaction(void)
+{
+#if !defined(__GLIBC__)
+    QSKIP("allocation counting needs glibc");
+#endif
+    QWidget window;
+    QTileLayout *layout = new QTileLayout(GRID_SIZE, GRID_SIZE, 16, 16, 1, 1);
+    window.setLayout(layout);
+    layout->beginUpdate();
+    for (int row = 4; row + 2 <= GRID_SIZE; row += 2) {
+        for (int column = 0; column + 2 <= GRID_SIZE; column += 2) {
+            layout->addWidget(new QWidget(), row, column, 2, 2);
+        }
+    }
+    layout->endUpdate();
+    QWidget *widget = new QWidget();
+    layout->addWidget(widget, 0, 2, 2, 2);
+    window.resize(GRID_SIZE * 17, GRID_SIZE * 17);
+    window.show();
+    QVERIFY(QTest::qWaitForWindowExposed(&window));
+
+    QTileDropData dropData;
+    dropData.id = layout->id;
+    dropData.rowSpan = 2;
+    dropData.columnSpan = 2;
+    QMimeData mimeData;
+    mimeData.setData(QTileWidget::MIME_TYPE_TILE_DATA, dropData.encode());
+
+    long allocations = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        allocations = 0;
+        for (int index = 0; index < ITERATION_COUNT; index++) {
+            // the left edge moves one column to the left, then back
+            allocations += this->resizeLeftEdge(widget, -24);
+            QCOMPARE(layout->tileOf(widget), QRect(1, 0, 3, 2));
+            allocations += this->resizeLeftEdge(widget, 18);
+            QCOMPARE(layout->tileOf(widget), QRect(2, 0, 2, 2));
+            allocations += this->enterDrag(layout, mimeData);
+        }
+    }
+    QCOMPARE(allocations, 0L);
+}
+
+QTEST_MAIN(TestQTileLayoutAllocations)
@@ -0,0 +1,24 @@
+#ifndef TST_QTILELAYOUTALLOCATIONS_H
+#define TST_QTILELAYOUTALLOCATIONS_H
+
+#include <QtTest/QTest>
+#include <QtWidgets/QWidget>
+#include "QTileLayout/qtilelayout.h"
+
+class TestQTileLayoutAllocations : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void interaction(void);
+
+protected:
+    long resizeLeftEdge(QWidget* const widget, const int x);
+    long enterDrag(QTileLayout* const layout, const QMimeData &mimeData);
+
+    static const int GRID_SIZE = 20;
+    static const int ITERATION_COUNT = 50;
+
+private:
+};
+#endif // TST_QTILELAYOUTALLOCATIONS_H
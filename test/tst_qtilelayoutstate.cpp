@@ -0,0 +1,235 @@
+#include "tst_qtilelayoutstate.h"
+
+/*
+ * Unit tests of QTileLayout::saveState and QTileLayout::restoreState.
+ * A saved state must restore the same tiles and axis sizes into a layout of any shape, and saving it again must
+ * give the same bytes. Every corrupt or hostile state (truncated, wrong magic or version, oversized counts, invalid
+ * entries) must be rejected before anything is changed, so the layout is compared with its previous tiles after
+ * each rejection.
+ */
+
+QTileLayout* TestQTileLayoutState::createLayout(QWidget &window, QHash<QString, QWidget*> &widgets)
+{
+    QTileLayout *layout = new QTileLayout(&window, 6, 8, 32, 32, 4, 4);
+    widgets = {
+        {"a", new QLabel("a")},
+        {"b", new QLabel("b")},
+        {"c", new QLabel("c")},
+    };
+    layout->addWidget(widgets["a"], 0, 0, 2, 2);
+    layout->addWidget(widgets["b"], 0, 3, 1, 3);
+    layout->addWidget(widgets["c"], 3, 1, 3, 2);
+    layout->setRowHeight(1, 50);
+    layout->setColumnWidth(4, 20);
+    return layout;
+}
+
+QHash<QWidget*, QString> TestQTileLayoutState::widgetIds(const QHash<QString, QWidget*> &widgets)
+{
+    QHash<QWidget*, QString> ids;
+    for (auto itr = widgets.constBegin(); itr != widgets.constEnd(); ++itr) {
+        ids.insert(itr.value(), itr.key());
+    }
+    return ids;
+}
+
+QHash<QWidget*, QRect> TestQTileLayoutState::tiles(QTileLayout* const layout)
+{
+    QHash<QWidget*, QRect> tiles;
+    for (QWidget *widget : layout->widgetList()) {
+        tiles.insert(widget, layout->tileOf(widget));
+    }
+    return tiles;
+}
+
+bool TestQTileLayoutState::isRejected(QTileLayout* const layout, const QHash<QString, QWidget*> &widgets, const QByteArray &state)
+{
+    QHash<QWidget*, QRect> previousTiles = tiles(layout);
+    int rows = layout->rows;
+    int columns = layout->columns;
+    if (layout->restoreState(state, widgets)) {
+        return false;
+    }
+    return (tiles(layout) == previousTiles) && (layout->rows == rows) && (layout->columns == columns);
+}
+
+QByteArray TestQTileLayoutState::encodeState(
+    const quint32 magic,
+    const quint16 version,
+    const qint32 rows,
+    const qint32 columns,
+    const QList<qint32> &sizes,
+    const quint32 count,
+    const QList<QPair<QString, QRect>> &entries
+)
+{
+    QByteArray state;
+    QDataStream stream(&state, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_6_0);
+    stream << magic << version;
+    stream << rows << columns;
+    stream << qint32(32) << qint32(32);
+    stream << qint32(4) << qint32(4);
+    for (qint32 size : sizes) {
+        stream << size;
+    }
+    stream << count;
+    for (const QPair<QString, QRect> &entry : entries) {
+        stream << entry.first;
+        stream << qint32(entry.second.y()) << qint32(entry.second.x());
+        stream << qint32(entry.second.height()) << qint32(entry.second.width());
+    }
+    return state;
+}
+
+void TestQTileLayoutState::roundTrip(void)
+{
+    QWidget window;
+    QHash<QString, QWidget*> widgets;
+    QTileLayout *layout = this->createLayout(window, widgets);
+    QByteArray state = layout->saveState(widgetIds(widgets));
+
+    QWidget otherWindow;
+    QTileLayout *otherLayout = new QTileLayout(&otherWindow, 2, 3, 16, 16, 1, 1);
+    QHash<QString, QWidget*> otherWidgets = {
+        {"a", new QLabel("a")},
+        {"b", new QLabel("b")},
+        {"c", new QLabel("c")},
+    };
+    otherLayout->addWidget(otherWidgets["b"], 0, 0);
+    QVERIFY(otherLayout->restoreState(state, otherWidgets));
+
+    QCOMPARE(otherLayout->rows, layout->rows);
+    QCOMPARE(otherLayout->columns, layout->columns);
+    QCOMPARE(otherLayout->verticalSpan, layout->verticalSpan);
+    QCOMPARE(otherLayout->horizontalSpan, layout->horizontalSpan);
+    QCOMPARE(otherLayout->verticalSpacing(), layout->verticalSpacing());
+    QCOMPARE(otherLayout->horizontalSpacing(), layout->horizontalSpacing());
+    for (int row = 0; row < layout->rows; row++) {
+        QCOMPARE(otherLayout->rowHeight(row), layout->rowHeight(row));
+    }
+    for (int column = 0; column < layout->columns; column++) {
+        QCOMPARE(otherLayout->columnWidth(column), layout->columnWidth(column));
+    }
+    for (const QString &id : widgets.keys()) {
+        QCOMPARE(otherLayout->tileOf(otherWidgets[id]), layout->tileOf(widgets[id]));
+    }
+    QCOMPARE(otherLayout->saveState(widgetIds(otherWidgets)), state);
+
+    // restoring into the layout the state was saved from brings back a removed widget
+    layout->removeWidget(widgets["b"]);
+    QCOMPARE(layout->tileOf(widgets["b"]), QRect());
+    QVERIFY(layout->restoreState(state, widgets));
+    QCOMPARE(layout->tileOf(widgets["b"]), QRect(3, 0, 3, 1));
+    QCOMPARE(layout->saveState(widgetIds(widgets)), state);
+}
+
+void TestQTileLayoutState::versionOneState(void)
+{
+    QWidget window;
+    QHash<QString, QWidget*> widgets;
+    QTileLayout *layout = this->createLayout(window, widgets);
+
+    QByteArray state = encodeState(STATE_MAGIC, 1, 4, 5, {}, 1, {{"c", QRect(2, 1, 3, 2)}});
+    QVERIFY(layout->restoreState(state, widgets));
+    QCOMPARE(layout->rows, 4);
+    QCOMPARE(layout->columns, 5);
+    QCOMPARE(layout->tileOf(widgets["c"]), QRect(2, 1, 3, 2));
+    QCOMPARE(layout->tileOf(widgets["a"]), QRect());
+    QCOMPARE(layout->widgetList(), QList<QWidget*>({widgets["c"]}));
+}
+
+void TestQTileLayoutState::truncatedState(void)
+{
+    QWidget window;
+    QHash<QString, QWidget*> widgets;
+    QTileLayout *layout = this->createLayout(window, widgets);
+    QByteArray state = layout->saveState(widgetIds(widgets));
+
+    for (int size = 0; size < state.size(); size++) {
+        QVERIFY2(isRejected(layout, widgets, state.left(size)), qPrintable(QString("prefix of %1 bytes").arg(size)));
+    }
+    QVERIFY(layout->restoreState(state, widgets));
+}
+
+void TestQTileLayoutState::wrongMagicOrVersion(void)
+{
+    QWidget window;
+    QHash<QString, QWidget*> widgets;
+    QTileLayout *layout = this->createLayout(window, widgets);
+    QList<qint32> sizes(6 + 8, 0);
+
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC + 1, STATE_VERSION, 6, 8, sizes, 0, {})));
+    QVERIFY(isRejected(layout, widgets, encodeState(0, STATE_VERSION, 6, 8, sizes, 0, {})));
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, 0, 6, 8, sizes, 0, {})));
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, STATE_VERSION + 1, 6, 8, sizes, 0, {})));
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, 0xFFFF, 6, 8, sizes, 0, {})));
+    QVERIFY(isRejected(layout, widgets, QByteArray(64, '\0')));
+}
+
+void TestQTileLayoutState::oversizedCounts(void)
+{
+    QWidget window;
+    QHash<QString, QWidget*> widgets;
+    QTileLayout *layout = this->createLayout(window, widgets);
+    QList<qint32> sizes(6 + 8, 0);
+
+    // more cells than any layout may have
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, 1, 1 << 20, 1 << 20, {}, 0, {})));
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, 1, 0x7FFFFFFF, 1, {}, 0, {})));
+    // an accepted cell count, but without the axis sizes it announces
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, STATE_VERSION, 4096, 4096, sizes, 0, {})));
+    // non-positive dimensions
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, 1, 0, 8, {}, 0, {})));
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, 1, 6, -1, {}, 0, {})));
+    // more entries than the remaining bytes can hold
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, STATE_VERSION, 6, 8, sizes, 0xFFFFFFFF, {})));
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, STATE_VERSION, 6, 8, sizes, 2, {{"a", QRect(0, 0, 1, 1)}})));
+}
+
+void TestQTileLayoutState::invalidEntries(void)
+{
+    QWidget window;
+    QHash<QString, QWidget*> widgets;
+    QTileLayout *layout = this->createLayout(window, widgets);
+    QList<qint32> sizes(6 + 8, 0);
+    QList<qint32> negativeSizes = sizes;
+    negativeSizes[2] = -1;
+
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, STATE_VERSION, 6, 8, negativeSizes, 0, {})));
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, STATE_VERSION, 6, 8, sizes, 2, {
+        {"a", QRect(0, 0, 3, 3)},
+        {"b", QRect(2, 2, 2, 2)},
+    })));
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, STATE_VERSION, 6, 8, sizes, 1, {{"a", QRect(7, 0, 2, 1)}})));
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, STATE_VERSION, 6, 8, sizes, 1, {{"a", QRect(0, -1, 1, 2)}})));
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, STATE_VERSION, 6, 8, sizes, 1, {{"a", QRect(0, 0, 0, 1)}})));
+    // an unknown id is skipped, but its entry must still lie on free cells
+    QVERIFY(isRejected(layout, widgets, encodeState(STATE_MAGIC, STATE_VERSION, 6, 8, sizes, 2, {
+        {"a", QRect(0, 0, 2, 2)},
+        {"unknown", QRect(1, 1, 2, 2)},
+    })));
+}
+
+void TestQTileLayoutState::unknownIds(void)
+{
+    QWidget window;
+    QHash<QString, QWidget*> widgets;
+    QTileLayout *layout = this->createLayout(window, widgets);
+    QList<qint32> sizes(6 + 8, 0);
+
+    QByteArray state = encodeState(STATE_MAGIC, STATE_VERSION, 6, 8, sizes, 3, {
+        {"unknown", QRect(0, 0, 2, 2)},
+        {"a", QRect(4, 4, 2, 2)},
+        {"c", QRect(0, 2, 1, 1)},
+    });
+    QVERIFY(layout->restoreState(state, widgets));
+    QCOMPARE(layout->tileOf(widgets["a"]), QRect(4, 4, 2, 2));
+    QCOMPARE(layout->tileOf(widgets["c"]), QRect(0, 2, 1, 1));
+    // the area of the unknown id stays free, and the widget left out of the state is no longer in the layout
+    QVERIFY(layout->isAreaEmpty(0, 0, 2, 2));
+    QCOMPARE(layout->tileOf(widgets["b"]), QRect());
+    QCOMPARE(layout->widgetList(), QList<QWidget*>({widgets["a"], widgets["c"]}));
+}
+
+QTEST_MAIN(TestQTileLayoutState)
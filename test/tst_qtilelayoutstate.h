@@ -0,0 +1,42 @@
+#ifndef TST_QTILELAYOUTSTATE_H
+#define TST_QTILELAYOUTSTATE_H
+
+#include <QtTest/QTest>
+#include <QtWidgets/QWidget>
+#include <QtWidgets/QLabel>
+#include "QTileLayout/qtilelayout.h"
+
+class TestQTileLayoutState : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void roundTrip(void);
+    void versionOneState(void);
+    void truncatedState(void);
+    void wrongMagicOrVersion(void);
+    void oversizedCounts(void);
+    void invalidEntries(void);
+    void unknownIds(void);
+
+protected:
+    QTileLayout* createLayout(QWidget &window, QHash<QString, QWidget*> &widgets);
+    static QHash<QWidget*, QString> widgetIds(const QHash<QString, QWidget*> &widgets);
+    static QHash<QWidget*, QRect> tiles(QTileLayout* const layout);
+    static bool isRejected(QTileLayout* const layout, const QHash<QString, QWidget*> &widgets, const QByteArray &state);
+    static QByteArray encodeState(
+        const quint32 magic,
+        const quint16 version,
+        const qint32 rows,
+        const qint32 columns,
+        const QList<qint32> &sizes,
+        const quint32 count,
+        const QList<QPair<QString, QRect>> &entries
+    );
+
+    static const quint32 STATE_MAGIC = 0x534C5451;
+    static const quint16 STATE_VERSION = 2;
+
+private:
+};
+#endif // TST_QTILELAYOUTSTATE_H